@@ -0,0 +1,766 @@
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common_defs.h"
+#include "gitdata.h"
+#include "linked_list.h"
+
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Keeps results alive so the compiler cannot drop the measured work.
+static volatile uintptr_t sink;
+
+// Number of lookups per length, so every run scans about the same volume.
+static int search_rounds(int length) {
+    int rounds = 20000000 / length;
+    if (rounds < 10) rounds = 10;
+    if (rounds > 10000) rounds = 10000;
+    return rounds;
+}
+
+// ********* Search *********
+
+void bench_search(int length) {
+    printf_yellow("  Search, %d values ...\n", length);
+    int rounds = search_rounds(length);
+    uint16_t *keys = malloc(rounds * sizeof(uint16_t));
+    srand(42);
+    for (int i = 0; i < rounds; i++) keys[i] = rand() % length;
+
+    List list;
+    list_init(&list, sizeof(Node) * length);
+    for (int i = 0; i < length; i++) list_insert(&list, i);
+    double start = now_ns();
+    for (int i = 0; i < rounds; i++)
+        sink += (uintptr_t)list_search(&list, keys[i]);
+    double list_ns = (now_ns() - start) / rounds;
+    list_cleanup(&list);
+
+    UnrolledList ulist;
+    ulist_init(&ulist,
+               sizeof(UnrolledNode) * (length / UNROLLED_CAPACITY + 1));
+    for (int i = 0; i < length; i++) ulist_insert(&ulist, i);
+    start = now_ns();
+    for (int i = 0; i < rounds; i++)
+        sink += (uintptr_t)ulist_search(&ulist, keys[i]).node;
+    double ulist_ns = (now_ns() - start) / rounds;
+    ulist_cleanup(&ulist);
+
+    // On average half of the list is scanned per lookup
+    printf("\tlist_search  %12.1f ns/op %8.3f ns/value\n", list_ns,
+           list_ns * 2 / length);
+    printf("\tulist_search %12.1f ns/op %8.3f ns/value (%.1fx)\n", ulist_ns,
+           ulist_ns * 2 / length, list_ns / ulist_ns);
+    free(keys);
+}
+
+// ********* Value index *********
+
+// The test_list_search_loop workload: append 0..length-1, then look each up.
+static double search_loop(int length, int indexed) {
+    List list;
+    list_init(&list, sizeof(Node) * length);
+    if (indexed) list_index_enable(&list);
+    for (int i = 0; i < length; i++) list_insert(&list, i);
+
+    double start = now_ns();
+    for (int i = 0; i < length; i++) sink += (uintptr_t)list_search(&list, i);
+    double elapsed = now_ns() - start;
+
+    list_cleanup(&list);
+    return elapsed / length;
+}
+
+void bench_index(int length) {
+    printf_yellow("  Search loop, %d values ---> ", length);
+    double scan_ns = search_loop(length, 0);
+    double index_ns = search_loop(length, 1);
+    printf_green("scan %.1f ns/op, index %.1f ns/op (%.0fx).\n", scan_ns,
+                 index_ns, scan_ns / index_ns);
+}
+
+// ********* Insert before *********
+
+// Grows a list from one node by inserting before the tail, the worst case for
+// a singly linked list which must find the predecessor first.
+void bench_insert_before(int length) {
+    printf_yellow("  Insert before tail, %d values ---> ", length);
+
+    List list;
+    list_init(&list, sizeof(Node) * length);
+    list_insert(&list, 0);
+    double start = now_ns();
+    for (int i = 1; i < length; i++) list_insert_before(&list, list.tail, i);
+    double singly_ns = (now_ns() - start) / (length - 1);
+    list_cleanup(&list);
+
+    DList dlist;
+    dlist_init(&dlist, sizeof(DNode) * length);
+    dlist_insert(&dlist, 0);
+    start = now_ns();
+    for (int i = 1; i < length; i++) dlist_insert_before(&dlist, dlist.tail, i);
+    double doubly_ns = (now_ns() - start) / (length - 1);
+    dlist_cleanup(&dlist);
+
+    printf_green("singly %.1f ns/op, doubly %.1f ns/op (%.0fx).\n", singly_ns,
+                 doubly_ns, singly_ns / doubly_ns);
+}
+
+// ********* Bulk load *********
+
+void bench_bulk(int length) {
+    printf_yellow("  Load and export, %d values ---> ", length);
+    uint16_t *values = malloc(length * sizeof(uint16_t));
+    for (int i = 0; i < length; i++) values[i] = i;
+
+    List list;
+    list_init(&list, sizeof(Node) * length);
+    double start = now_ns();
+    for (int i = 0; i < length; i++) list_insert(&list, values[i]);
+    double insert_ns = (now_ns() - start) / length;
+    list_cleanup(&list);
+
+    start = now_ns();
+    list_from_array(&list, values, length);
+    double bulk_ns = (now_ns() - start) / length;
+    start = now_ns();
+    sink += list_to_array(&list, values, length);
+    double export_ns = (now_ns() - start) / length;
+    list_cleanup(&list);
+
+    free(values);
+    printf_green("list_insert %.2f ns/value, list_from_array %.2f ns/value, "
+                 "list_to_array %.2f ns/value.\n",
+                 insert_ns, bulk_ns, export_ns);
+}
+
+// ********* Display *********
+
+// The display loop as it was before buffering: one printf per element.
+static void display_printf(List *list, FILE *stream) {
+    fprintf(stream, "[");
+    for (Node *node = list->head; node; node = node->next) {
+        fprintf(stream, "%d", node->data);
+        if (node->next) fprintf(stream, ", ");
+    }
+    fprintf(stream, "]");
+}
+
+void bench_display(int length) {
+    printf_yellow("  Dump %d values to /dev/null ---> ", length);
+    List list;
+    list_init(&list, sizeof(Node) * length);
+    for (int i = 0; i < length; i++) list_insert(&list, rand());
+    FILE *devnull = fopen("/dev/null", "w");
+
+    double start = now_ns();
+    display_printf(&list, devnull);
+    fflush(devnull);
+    double printf_ms = (now_ns() - start) / 1e6;
+
+    start = now_ns();
+    list_display_range_to(&list, NULL, NULL, devnull);
+    fflush(devnull);
+    double stream_ms = (now_ns() - start) / 1e6;
+
+    start = now_ns();
+    list_display_range_fd(&list, NULL, NULL, fileno(devnull));
+    double fd_ms = (now_ns() - start) / 1e6;
+
+    fclose(devnull);
+    list_cleanup(&list);
+    printf_green("printf %.1f ms, stream %.1f ms, fd %.1f ms.\n", printf_ms,
+                 stream_ms, fd_ms);
+}
+
+// ********* Shared pool *********
+
+#define CHURN_ROUNDS 200
+
+typedef struct ChurnWorker {
+    List *lists;
+    int count;
+} ChurnWorker;
+
+// Refills and drains each of its lists, then cleans them up. Node allocation
+// never reaches the memory manager, and the final cleanups are remote frees.
+static void *churn_main(void *arg) {
+    ChurnWorker *worker = arg;
+    for (int round = 0; round < CHURN_ROUNDS; round++)
+        for (int i = 0; i < worker->count; i++) {
+            List *list = &worker->lists[i];
+            for (int k = 0; k < 8; k++) list_insert(list, k);
+            for (int k = 0; k < 8; k++) list_delete(list, k);
+        }
+    for (int i = 0; i < worker->count; i++) list_cleanup(&worker->lists[i]);
+    return NULL;
+}
+
+void bench_shared_pool(int lists, int threads) {
+    printf_yellow("  %d lists, %d threads ---> ", lists, threads);
+    size_t list_size = sizeof(Node) * 8;
+    mem_init((list_size + NODE_POOL_SLACK) * lists);
+    List *all = malloc(lists * sizeof(List));
+
+    // Creation and cleanup both stay on the owner thread here
+    double start = now_ns();
+    for (int i = 0; i < lists; i++) list_attach(&all[i], list_size);
+    double attach_ns = (now_ns() - start) / lists;
+    start = now_ns();
+    for (int i = 0; i < lists; i++) list_cleanup(&all[i]);
+    double cleanup_ns = (now_ns() - start) / lists;
+
+    for (int i = 0; i < lists; i++) list_attach(&all[i], list_size);
+    pthread_t tids[threads];
+    ChurnWorker workers[threads];
+    start = now_ns();
+    for (int t = 0; t < threads; t++) {
+        int first = lists * t / threads, last = lists * (t + 1) / threads;
+        workers[t] = (ChurnWorker){&all[first], last - first};
+        pthread_create(&tids[t], NULL, churn_main, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    double churn_ns = (now_ns() - start) / ((double)lists * CHURN_ROUNDS * 16);
+
+    free(all);
+    mem_deinit();
+    printf_green("attach %.1f ns, cleanup %.1f ns, churn %.1f ns/op.\n",
+                 attach_ns, cleanup_ns, churn_ns);
+}
+
+// ********* Compaction *********
+
+static double traverse_ns(List *list) {
+    int rounds = search_rounds(list->count) / 10 + 1;
+    double start = now_ns();
+    for (int r = 0; r < rounds; r++)
+        for (Node *node = list->head; node; node = node->next)
+            sink += node->data;
+    return (now_ns() - start) / rounds / list->count;
+}
+
+// Builds a list of 0..length-1 with each value inserted after a random
+// earlier node, so traversal order has nothing to do with placement in the
+// region.
+static void scattered_list(List *list, int length) {
+    list_init(list, sizeof(Node) * length);
+    Node **nodes = malloc(length * sizeof(Node *));
+    list_insert(list, 0);
+    nodes[0] = list->head;
+    srand(42);
+    for (int i = 1; i < length; i++) {
+        Node *prev_node = nodes[rand() % i];
+        list_insert_after(list, prev_node, i);
+        nodes[i] = prev_node->next;
+    }
+    free(nodes);
+}
+
+void bench_compact(int length) {
+    printf_yellow("  Traverse churned list, %d values ---> ", length);
+    List list;
+    scattered_list(&list, length);
+
+    double churned_ns = traverse_ns(&list);
+    double start = now_ns();
+    list_compact(&list, NULL);
+    double compact_ms = (now_ns() - start) / 1e6;
+    double compacted_ns = traverse_ns(&list);
+    list_cleanup(&list);
+
+    printf_green("churned %.2f ns/node, compacted %.2f ns/node (%.1fx), "
+                 "compaction %.1f ms.\n",
+                 churned_ns, compacted_ns, churned_ns / compacted_ns,
+                 compact_ms);
+}
+
+// ********* Batched iteration *********
+
+static void sum_values(const uint16_t *values, size_t count, void *ctx) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) sum += values[i];
+    *(uint64_t *)ctx += sum;
+}
+
+// Times a sum over the list by a plain loop and by list_visit.
+static void visit_run(List *list, const char *label) {
+    int rounds = search_rounds(list->count) / 10 + 1;
+    double start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        uint64_t sum = 0;
+        for (Node *node = list->head; node; node = node->next)
+            sum += node->data;
+        sink += sum;
+    }
+    double loop_ns = (now_ns() - start) / rounds / list->count;
+
+    start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        uint64_t sum = 0;
+        list_visit(list, sum_values, &sum);
+        sink += sum;
+    }
+    double visit_ns = (now_ns() - start) / rounds / list->count;
+    printf("\t%-9s loop %6.2f ns/value, list_visit %6.2f ns/value\n", label,
+           loop_ns, visit_ns);
+}
+
+void bench_visit(int length) {
+    printf_yellow("  Sum of %d values ...\n", length);
+    List list;
+    scattered_list(&list, length);
+
+    visit_run(&list, "scattered");
+    list_compact(&list, NULL);
+    visit_run(&list, "compacted");
+    list_cleanup(&list);
+}
+
+// ********* Operation suite *********
+
+// Cache misses of this thread, counted through perf_event_open when the
+// kernel allows it; -1 when it does not.
+static int cache_miss_fd() {
+    static int fd = -2;
+    if (fd == -2) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    return fd;
+}
+
+static double cache_misses() {
+    uint64_t misses = 0;
+    int fd = cache_miss_fd();
+    if (fd >= 0 && read(fd, &misses, sizeof(misses)) != sizeof(misses))
+        misses = 0;
+    return misses;
+}
+
+typedef struct Phase {
+    double ns;
+    double misses;
+} Phase;
+
+static void phase_begin(Phase *phase) {
+    phase->misses = cache_misses();
+    phase->ns = now_ns();
+}
+
+static void phase_end(Phase *phase, long ops) {
+    phase->ns = (now_ns() - phase->ns) / ops;
+    phase->misses = (cache_misses() - phase->misses) / ops;
+}
+
+static void print_phase(const char *op, Phase *list, Phase *array) {
+    printf("\t%-14s %12.1f", op, list->ns);
+    if (cache_miss_fd() >= 0)
+        printf(" %10.2f", list->misses);
+    else
+        printf(" %10s", "-");
+    printf(" %12.1f", array->ns);
+    if (cache_miss_fd() >= 0)
+        printf(" %10.2f\n", array->misses);
+    else
+        printf(" %10s\n", "-");
+}
+
+// Inserts `data` at `pos` in a plain array holding `*count` values.
+static void array_insert_at(uint16_t *values, size_t *count, size_t pos,
+                            uint16_t data) {
+    memmove(values + pos + 1, values + pos, (*count - pos) * sizeof(uint16_t));
+    values[pos] = data;
+    (*count)++;
+}
+
+// Position of the first `data` in a plain array, or `count` if missing.
+static size_t array_find(uint16_t *values, size_t count, uint16_t data) {
+    size_t i = 0;
+    while (i < count && values[i] != data) i++;
+    return i;
+}
+
+// Times every list operation at one length next to the same work on a plain
+// array. Constant time operations run `quick` times, linear ones `rounds`.
+void bench_ops(int length) {
+    printf_yellow("  %d values ...\n", length);
+    int rounds = search_rounds(length);
+    int quick = length < 100000 ? length : 100000;
+    int *positions = malloc(quick * sizeof(int));
+    uint16_t *keys = malloc(rounds * sizeof(uint16_t));
+    srand(42);
+    for (int i = 0; i < quick; i++) positions[i] = rand() % length;
+    for (int i = 0; i < rounds; i++) keys[i] = rand() % length;
+
+    enum {
+        INSERT,
+        INSERT_AFTER,
+        INSERT_BEFORE,
+        SEARCH,
+        DELETE,
+        COUNT,
+        CLEANUP
+    };
+    const char *names[] = {"insert", "insert_after", "insert_before", "search",
+                           "delete", "count",        "cleanup"};
+    Phase list_phase[7], array_phase[7];
+
+    List list;
+    list_init(&list, sizeof(Node) * ((size_t)length + quick + rounds));
+    phase_begin(&list_phase[INSERT]);
+    for (int i = 0; i < length; i++) list_insert(&list, i);
+    phase_end(&list_phase[INSERT], length);
+
+    Node **nodes = malloc(length * sizeof(Node *));
+    int i = 0;
+    for (Node *node = list.head; node; node = node->next) nodes[i++] = node;
+
+    phase_begin(&list_phase[INSERT_AFTER]);
+    for (i = 0; i < quick; i++)
+        list_insert_after(&list, nodes[positions[i]], i);
+    phase_end(&list_phase[INSERT_AFTER], quick);
+
+    phase_begin(&list_phase[INSERT_BEFORE]);
+    for (i = 0; i < rounds; i++)
+        list_insert_before(&list, nodes[positions[i % quick]], i);
+    phase_end(&list_phase[INSERT_BEFORE], rounds);
+
+    phase_begin(&list_phase[SEARCH]);
+    for (i = 0; i < rounds; i++) sink += (uintptr_t)list_search(&list, keys[i]);
+    phase_end(&list_phase[SEARCH], rounds);
+
+    phase_begin(&list_phase[DELETE]);
+    for (i = 0; i < rounds; i++) list_delete(&list, keys[i]);
+    phase_end(&list_phase[DELETE], rounds);
+
+    phase_begin(&list_phase[COUNT]);
+    for (i = 0; i < quick; i++) sink += list_count_nodes(&list);
+    phase_end(&list_phase[COUNT], quick);
+
+    phase_begin(&list_phase[CLEANUP]);
+    list_cleanup(&list);
+    phase_end(&list_phase[CLEANUP], 1);
+    free(nodes);
+
+    // The same sequence on a plain array. Middle insertions shift the tail,
+    // so they run `rounds` times as well.
+    size_t count = 0;
+    phase_begin(&array_phase[INSERT]);
+    uint16_t *values = malloc(((size_t)length + 2 * rounds) * sizeof(uint16_t));
+    for (i = 0; i < length; i++) values[count++] = i;
+    phase_end(&array_phase[INSERT], length);
+
+    phase_begin(&array_phase[INSERT_AFTER]);
+    for (i = 0; i < rounds; i++)
+        array_insert_at(values, &count, positions[i % quick] + 1, i);
+    phase_end(&array_phase[INSERT_AFTER], rounds);
+
+    phase_begin(&array_phase[INSERT_BEFORE]);
+    for (i = 0; i < rounds; i++)
+        array_insert_at(values, &count, positions[i % quick], i);
+    phase_end(&array_phase[INSERT_BEFORE], rounds);
+
+    phase_begin(&array_phase[SEARCH]);
+    for (i = 0; i < rounds; i++) sink += array_find(values, count, keys[i]);
+    phase_end(&array_phase[SEARCH], rounds);
+
+    phase_begin(&array_phase[DELETE]);
+    for (i = 0; i < rounds; i++) {
+        size_t pos = array_find(values, count, keys[i]);
+        if (pos == count) continue;
+        memmove(values + pos, values + pos + 1,
+                (count - pos - 1) * sizeof(uint16_t));
+        count--;
+    }
+    phase_end(&array_phase[DELETE], rounds);
+
+    phase_begin(&array_phase[COUNT]);
+    for (i = 0; i < quick; i++) sink += count;
+    phase_end(&array_phase[COUNT], quick);
+
+    phase_begin(&array_phase[CLEANUP]);
+    free(values);
+    phase_end(&array_phase[CLEANUP], 1);
+
+    printf("\t%-14s %12s %10s %12s %10s\n", "", "list ns/op", "misses/op",
+           "array ns/op", "misses/op");
+    for (int op = INSERT; op <= CLEANUP; op++)
+        print_phase(names[op], &list_phase[op], &array_phase[op]);
+    free(positions);
+    free(keys);
+}
+
+// ********* Serialization *********
+
+static long file_size(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+void bench_save_load(int length) {
+    printf_yellow("  Save and load %d sorted values ...\n", length);
+    const char *path = "/tmp/bench_linked_list.bin";
+    uint16_t *values = malloc(length * sizeof(uint16_t));
+    for (int i = 0; i < length; i++) values[i] = (uint64_t)i * 65536 / length;
+    List list, loaded;
+    list_from_array(&list, values, length);
+    free(values);
+
+    const char *names[] = {"raw", "delta"};
+    ListEncoding encodings[] = {LIST_ENCODING_RAW, LIST_ENCODING_DELTA};
+    for (int e = 0; e < 2; e++) {
+        double start = now_ns();
+        list_save(&list, path, encodings[e]);
+        double save_ms = (now_ns() - start) / 1e6;
+        start = now_ns();
+        list_load(&loaded, path);
+        double load_ms = (now_ns() - start) / 1e6;
+        list_cleanup(&loaded);
+        printf("\t%-6s save %7.1f ms, load %7.1f ms, %9ld bytes\n", names[e],
+               save_ms, load_ms, file_size(path));
+    }
+    list_cleanup(&list);
+    unlink(path);
+}
+
+// ********* Concurrency *********
+
+#define CONC_KEYS 1024
+#define CONC_OPS 200000
+
+typedef struct ConcBench {
+    ConcList *conc;
+    List *list;
+    pthread_mutex_t *lock;
+    unsigned seed;
+} ConcBench;
+
+// 90% lookups, 5% inserts and 5% deletes over a fixed key range.
+static void *conc_bench_main(void *arg) {
+    ConcBench *bench = arg;
+    ConcThread *self = bench->conc ? conclist_attach(bench->conc) : NULL;
+    unsigned seed = bench->seed;
+    for (int i = 0; i < CONC_OPS; i++) {
+        int op = rand_r(&seed) % 100;
+        uint16_t key = rand_r(&seed) % CONC_KEYS;
+        if (bench->conc) {
+            if (op < 90)
+                sink += conclist_contains(bench->conc, self, key);
+            else if (op < 95) {
+                // Both lists allow duplicates; keep the key range a set
+                if (!conclist_contains(bench->conc, self, key))
+                    conclist_insert(bench->conc, self, key);
+            } else
+                conclist_delete(bench->conc, self, key);
+        } else {
+            pthread_mutex_lock(bench->lock);
+            if (op < 90)
+                sink += (uintptr_t)list_search(bench->list, key);
+            else if (op < 95) {
+                if (!list_search(bench->list, key))
+                    list_insert(bench->list, key);
+            } else
+                list_delete(bench->list, key);
+            pthread_mutex_unlock(bench->lock);
+        }
+    }
+    return NULL;
+}
+
+static double conc_bench_run(int threads, ConcList *conc, List *list,
+                             pthread_mutex_t *lock) {
+    pthread_t tids[threads];
+    ConcBench benches[threads];
+    double start = now_ns();
+    for (int t = 0; t < threads; t++) {
+        benches[t] = (ConcBench){conc, list, lock, 42 + t};
+        pthread_create(&tids[t], NULL, conc_bench_main, &benches[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    return threads * CONC_OPS / ((now_ns() - start) / 1e3);
+}
+
+void bench_concurrent(int threads) {
+    printf_yellow("  Mixed workload, %d threads ---> ", threads);
+
+    // Static rather than malloc'd so the per-thread slots get their
+    // cache-line alignment
+    static ConcList conc_storage;
+    ConcList *conc = &conc_storage;
+    conclist_init(conc, sizeof(ConcNode) * CONC_KEYS * 16);
+    ConcThread *self = conclist_attach(conc);
+    for (int key = 0; key < CONC_KEYS; key += 2)
+        conclist_insert(conc, self, key);
+    double conc_mops = conc_bench_run(threads, conc, NULL, NULL);
+    conclist_cleanup(conc);
+
+    List list;
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    list_init(&list, sizeof(Node) * CONC_KEYS);
+    for (int key = 0; key < CONC_KEYS; key += 2) list_insert(&list, key);
+    double mutex_mops = conc_bench_run(threads, NULL, &list, &lock);
+    list_cleanup(&list);
+
+    printf_green("lock-free %.2f Mops/s, mutex %.2f Mops/s.\n", conc_mops,
+                 mutex_mops);
+}
+
+int main(int argc, char *argv[]) {
+#ifdef VERSION
+    printf("Build Version; %s \n", VERSION);
+#endif
+    printf("Git Version; %s/%s \n", git_date, git_sha);
+
+    if (argc < 2) {
+        printf("Usage: %s <benchmark>\n", argv[0]);
+        printf("Available benchmarks:\n");
+        printf(
+            " 1. bench_search - list_search versus vectorized unrolled "
+            "search\n");
+        printf(
+            " 2. bench_index - Search loop with and without the value "
+            "index\n");
+        printf(
+            " 3. bench_insert_before - Singly versus doubly linked insert "
+            "before\n");
+        printf(
+            " 4. bench_concurrent - Lock-free list versus mutex-guarded "
+            "list\n");
+        printf(
+            " 5. bench_bulk - list_insert loop versus list_from_array and "
+            "list_to_array\n");
+        printf(
+            " 6. bench_display - Per-element printf versus buffered "
+            "display\n");
+        printf(
+            " 7. bench_shared_pool - Many small lists in one pool, churned "
+            "by several threads\n");
+        printf(
+            " 8. bench_compact - Traversal of a churned list before and after "
+            "list_compact\n");
+        printf(
+            " 9. bench_visit - Plain loop versus batched, prefetching "
+            "list_visit\n");
+        printf(
+            " 10. bench_ops - Every list operation from 1e2 to 1e7 values "
+            "versus a plain array\n");
+        printf(
+            " 11. bench_save_load - Binary list_save and list_load, raw and "
+            "delta encoded\n");
+        printf(" 0. Run all benchmarks\n");
+        return 1;
+    }
+
+    switch (atoi(argv[1])) {
+        case 0:
+            printf("Benchmarking Search:\n");
+            for (int length = 100; length <= 100000; length *= 10)
+                bench_search(length);
+
+            printf("\nBenchmarking Value Index:\n");
+            for (int length = 100; length <= 10000; length *= 10)
+                bench_index(length);
+            bench_index(UINT16_MAX + 1);
+
+            printf("\nBenchmarking Insert Before:\n");
+            for (int length = 100; length <= 10000; length *= 10)
+                bench_insert_before(length);
+
+            printf("\nBenchmarking Concurrency:\n");
+            for (int threads = 1; threads <= 8; threads *= 2)
+                bench_concurrent(threads);
+
+            printf("\nBenchmarking Bulk Load:\n");
+            bench_bulk(1000000);
+
+            printf("\nBenchmarking Display:\n");
+            bench_display(1000000);
+
+            printf("\nBenchmarking Shared Pool:\n");
+            for (int threads = 1; threads <= 4; threads *= 2)
+                bench_shared_pool(10000, threads);
+
+            printf("\nBenchmarking Compaction:\n");
+            for (int length = 10000; length <= 1000000; length *= 10)
+                bench_compact(length);
+
+            printf("\nBenchmarking Batched Iteration:\n");
+            for (int length = 10000; length <= 1000000; length *= 10)
+                bench_visit(length);
+
+            printf("\nBenchmarking Operations:\n");
+            for (int length = 100; length <= 10000000; length *= 10)
+                bench_ops(length);
+
+            printf("\nBenchmarking Serialization:\n");
+            bench_save_load(1000000);
+            bench_save_load(10000000);
+            break;
+        case 1:
+            for (int length = 100; length <= 100000; length *= 10)
+                bench_search(length);
+            break;
+        case 2:
+            for (int length = 100; length <= 10000; length *= 10)
+                bench_index(length);
+            bench_index(UINT16_MAX + 1);
+            break;
+        case 3:
+            for (int length = 100; length <= 10000; length *= 10)
+                bench_insert_before(length);
+            break;
+        case 4:
+            for (int threads = 1; threads <= 8; threads *= 2)
+                bench_concurrent(threads);
+            break;
+        case 5:
+            bench_bulk(1000000);
+            break;
+        case 6:
+            bench_display(1000000);
+            break;
+        case 7:
+            for (int threads = 1; threads <= 4; threads *= 2)
+                bench_shared_pool(10000, threads);
+            break;
+        case 8:
+            for (int length = 10000; length <= 1000000; length *= 10)
+                bench_compact(length);
+            break;
+        case 9:
+            for (int length = 10000; length <= 1000000; length *= 10)
+                bench_visit(length);
+            break;
+        case 10:
+            for (int length = 100; length <= 10000000; length *= 10)
+                bench_ops(length);
+            break;
+        case 11:
+            bench_save_load(1000000);
+            bench_save_load(10000000);
+            break;
+        default:
+            printf("Invalid benchmark\n");
+            break;
+    }
+    return 0;
+}
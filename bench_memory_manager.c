@@ -0,0 +1,275 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common_defs.h"
+#include "gitdata.h"
+#include "memory_manager.h"
+
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ********* Producer/consumer *********
+
+#define RING_SIZE 1024
+
+// Single-producer single-consumer ring used to hand blocks to the consumer.
+typedef struct Ring {
+    void *slots[RING_SIZE];
+    _Atomic size_t head;
+    _Atomic size_t tail;
+} Ring;
+
+static void ring_push(Ring *ring, void *block) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) ==
+           RING_SIZE)
+        sched_yield();
+    ring->slots[head % RING_SIZE] = block;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static void *ring_pop(Ring *ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    while (atomic_load_explicit(&ring->head, memory_order_acquire) == tail)
+        sched_yield();
+    void *block = ring->slots[tail % RING_SIZE];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return block;
+}
+
+typedef struct Consumer {
+    Ring *ring;
+    int count;
+} Consumer;
+
+static void *consumer_main(void *arg) {
+    Consumer *consumer = arg;
+    for (int i = 0; i < consumer->count; i++) mem_free(ring_pop(consumer->ring));
+    return NULL;
+}
+
+void bench_producer_consumer(int count, size_t block_size) {
+    printf_yellow("  Producer/consumer, %d blocks of %zu bytes ---> ", count,
+                  block_size);
+
+    // Room for everything in flight: the ring plus frees not yet reclaimed.
+    mem_init(block_size * RING_SIZE * 4);
+
+    // Reference: the owner allocates and frees everything itself.
+    double start = now_ns();
+    for (int i = 0; i < count; i++) mem_free(mem_alloc(block_size));
+    double local_ns = (now_ns() - start) / count;
+
+    Ring *ring = calloc(1, sizeof(Ring));
+    Consumer consumer = {ring, count};
+    pthread_t thread;
+
+    start = now_ns();
+    pthread_create(&thread, NULL, consumer_main, &consumer);
+    for (int i = 0; i < count; i++) {
+        void *block;
+        while (!(block = mem_alloc(block_size))) sched_yield();
+        ring_push(ring, block);
+    }
+    pthread_join(thread, NULL);
+    double remote_ns = (now_ns() - start) / count;
+
+    free(ring);
+    mem_deinit();
+    printf_green("owner-only %.1f ns/op, remote free %.1f ns/op.\n", local_ns,
+                 remote_ns);
+}
+
+// ********* Fragmentation *********
+
+// Largest single block the pool can still hand out, found by bisection.
+static size_t largest_free_block(size_t pool_size) {
+    size_t low = 0, high = pool_size;
+    while (low < high) {
+        size_t mid = low + (high - low + 1) / 2;
+        void *block = mem_alloc(mid);
+        if (block) {
+            mem_free(block);
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+static void fragmentation_run(int count, size_t pool_size, int hinted) {
+    mem_init(pool_size);
+    void **transient = malloc(count * sizeof(void *));
+    size_t live = 0;
+
+    // Interleave small long-lived records with short-lived buffers
+    srand(42);
+    for (int i = 0; i < count; i++) {
+        size_t buffer_size = 64 + rand() % 448;
+        mem_alloc_hinted(48, hinted ? MEM_HINT_LONG_LIVED : MEM_HINT_DEFAULT);
+        transient[i] = mem_alloc_hinted(
+            buffer_size, hinted ? MEM_HINT_TRANSIENT : MEM_HINT_DEFAULT);
+        live += 48;
+    }
+    for (int i = 0; i < count; i++) mem_free(transient[i]);
+
+    size_t largest = largest_free_block(pool_size);
+    printf("\t%-8s largest free block %8zu of %8zu free bytes (%.1f%%)\n",
+           hinted ? "hinted" : "unhinted", largest, pool_size - live,
+           100.0 * largest / (pool_size - live));
+
+    free(transient);
+    mem_deinit();
+}
+
+void bench_fragmentation(int count) {
+    printf_yellow("  Fragmentation after freeing %d transient buffers ...\n",
+                  count);
+    size_t pool_size = count * 400;
+    fragmentation_run(count, pool_size, 0);
+    fragmentation_run(count, pool_size, 1);
+}
+
+// ********* Call overhead *********
+
+void bench_small_fast_path(int count, size_t block_size) {
+    printf_yellow("  Alloc/free pairs of %zu bytes ---> ", block_size);
+    mem_init(1 << 20);
+
+    // A few live blocks so the pool search is not trivially short
+    void *live[32];
+    for (int i = 0; i < 32; i++) live[i] = mem_alloc(block_size);
+
+    double start = now_ns();
+    for (int i = 0; i < count; i++) {
+        void *block = mem_alloc(block_size);
+        mem_free(block);
+    }
+    double library_ns = (now_ns() - start) / count;
+
+    start = now_ns();
+    for (int i = 0; i < count; i++) {
+        void *block = mem_alloc_small(block_size);
+        mem_free_small(block, block_size);
+    }
+    double inline_ns = (now_ns() - start) / count;
+
+    for (int i = 0; i < 32; i++) mem_free(live[i]);
+    mem_small_flush();
+    mem_deinit();
+    printf_green("mem_alloc %.1f ns/op, mem_alloc_small %.1f ns/op.\n",
+                 library_ns, inline_ns);
+}
+
+// ********* Checkpoint *********
+
+// The state a harness would reset to: `count` blocks of assorted sizes with
+// every other one freed again.
+static void build_state(int count) {
+    void **blocks = malloc(count * sizeof(void *));
+    srand(42);
+    for (int i = 0; i < count; i++) blocks[i] = mem_alloc(16 + rand() % 240);
+    for (int i = 0; i < count; i += 2) mem_free(blocks[i]);
+    free(blocks);
+}
+
+void bench_checkpoint(int count) {
+    printf_yellow("  Reset to a heap of %d blocks ---> ", count);
+    size_t pool_size = (size_t)count * 256;
+    int rounds = 20;
+
+    double start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        mem_init(pool_size);
+        build_state(count);
+        mem_deinit();
+    }
+    double rebuild_us = (now_ns() - start) / rounds / 1e3;
+
+    mem_init(pool_size);
+    build_state(count);
+    MemCheckpoint *checkpoint = mem_checkpoint();
+    start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        mem_alloc(1000);  // Disturb the state a little
+        mem_restore(checkpoint);
+    }
+    double restore_us = (now_ns() - start) / rounds / 1e3;
+    mem_checkpoint_free(checkpoint);
+    mem_deinit();
+
+    printf_green("rebuild %.1f us, mem_restore %.1f us.\n", rebuild_us,
+                 restore_us);
+}
+
+int main(int argc, char *argv[]) {
+#ifdef VERSION
+    printf("Build Version; %s \n", VERSION);
+#endif
+    printf("Git Version; %s/%s \n", git_date, git_sha);
+
+    if (argc < 2) {
+        printf("Usage: %s <benchmark>\n", argv[0]);
+        printf("Available benchmarks:\n");
+        printf(
+            " 1. bench_producer_consumer - One thread allocates, another "
+            "frees\n");
+        printf(
+            " 2. bench_fragmentation - Largest free block with and without "
+            "lifetime hints\n");
+        printf(
+            " 3. bench_small_fast_path - Library call versus inline fast "
+            "path\n");
+        printf(
+            " 4. bench_checkpoint - Rebuilding a heap versus restoring a "
+            "checkpoint\n");
+        printf(" 0. Run all benchmarks\n");
+        return 1;
+    }
+
+    switch (atoi(argv[1])) {
+        case 0:
+            printf("Benchmarking Threading:\n");
+            bench_producer_consumer(200000, 16);
+            bench_producer_consumer(200000, 256);
+
+            printf("\nBenchmarking Placement:\n");
+            bench_fragmentation(2000);
+
+            printf("\nBenchmarking Call Overhead:\n");
+            bench_small_fast_path(10000000, 16);
+            bench_small_fast_path(10000000, 64);
+
+            printf("\nBenchmarking Checkpoints:\n");
+            bench_checkpoint(1000);
+            bench_checkpoint(10000);
+            break;
+        case 1:
+            bench_producer_consumer(200000, 16);
+            bench_producer_consumer(200000, 256);
+            break;
+        case 2:
+            bench_fragmentation(2000);
+            break;
+        case 3:
+            bench_small_fast_path(10000000, 16);
+            bench_small_fast_path(10000000, 64);
+            break;
+        case 4:
+            bench_checkpoint(1000);
+            bench_checkpoint(10000);
+            break;
+        default:
+            printf("Invalid benchmark\n");
+            break;
+    }
+    return 0;
+}
@@ -1,52 +1,542 @@
 #include "linked_list.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LIST_X86_SIMD
+#endif
+
+// Turns a pointer to a node's `next` field back into the node.
+#define NODE_OF_LINK(link) ((Node *)((char *)(link) - offsetof(Node, next)))
+
+// ********* Node pool *********
+
+/**
+ * @brief Rounds a block from the memory manager up to pointer alignment, since
+ * the memory manager does not align blocks and nodes hold pointers.
+ *
+ * @param block The block, which must be NODE_POOL_SLACK bytes larger than
+ * what is placed at the result.
+ * @return The first pointer-aligned address in the block.
+ */
+static void *align_block(void *block) {
+    uintptr_t start = (uintptr_t)block;
+    return (void *)((start + sizeof(void *) - 1) & ~(sizeof(void *) - 1));
+}
+
+/**
+ * @brief Finds where the pool's first node lies in its region.
+ *
+ * @param pool A pointer to the node pool.
+ * @return The region's start rounded up to pointer alignment.
+ */
+static void *node_pool_first(NodePool *pool) {
+    return align_block(pool->region);
+}
+
+/**
+ * @brief Carves a node pool out of the memory manager. The region is
+ * NODE_POOL_SLACK bytes larger than `size`, so `size` bytes of nodes fit
+ * after aligning its start.
+ *
+ * @param pool A pointer to the node pool.
+ * @param size The size in bytes of the nodes to hold.
+ * @param node_size The size in bytes of one node.
+ * @param link_offset The offset of the node's next pointer.
+ */
+static void node_pool_init(NodePool *pool, size_t size, size_t node_size,
+                           size_t link_offset) {
+    pool->region =
+        mem_alloc_hinted(size + NODE_POOL_SLACK, MEM_HINT_LONG_LIVED);
+    pool->free = NULL;
+    pool->node_size = node_size;
+    pool->link_offset = link_offset;
+    if (!pool->region) {
+        pool->bump = pool->end = NULL;
+        return;
+    }
+
+    pool->bump = node_pool_first(pool);
+    pool->end = pool->bump + size;
+}
+
+/**
+ * @brief Takes a node from the pool.
+ *
+ * @param pool A pointer to the node pool.
+ * @return A pointer to the node, or NULL if the pool is exhausted.
+ */
+static void *node_pool_alloc(NodePool *pool) {
+    void *node = pool->free;
+    if (node) {
+        pool->free = *(void **)((char *)node + pool->link_offset);
+        return node;
+    }
+    if ((size_t)(pool->end - pool->bump) < pool->node_size) return NULL;
+    node = pool->bump;
+    pool->bump += pool->node_size;
+    return node;
+}
+
+/**
+ * @brief Takes up to `*count` never-used nodes lying back to back in the pool.
+ *
+ * @param pool A pointer to the node pool.
+ * @param count The number of nodes wanted; set to the number taken.
+ * @return A pointer to the first node of the run.
+ */
+static void *node_pool_alloc_run(NodePool *pool, size_t *count) {
+    size_t room = pool->bump ? (pool->end - pool->bump) / pool->node_size : 0;
+    if (*count > room) *count = room;
+    void *run = pool->bump;
+    pool->bump += *count * pool->node_size;
+    return run;
+}
+
+/**
+ * @brief Returns a node to the pool.
+ *
+ * @param pool A pointer to the node pool.
+ * @param node A pointer to the node.
+ */
+static void node_pool_free(NodePool *pool, void *node) {
+    *(void **)((char *)node + pool->link_offset) = pool->free;
+    pool->free = node;
+}
+
+/**
+ * @brief Returns a chain of nodes, already linked through their link fields,
+ * to the pool at once.
+ *
+ * @param pool A pointer to the node pool.
+ * @param first The first node of the chain.
+ * @param last The last node of the chain.
+ */
+static void node_pool_free_chain(NodePool *pool, void *first, void *last) {
+    *(void **)((char *)last + pool->link_offset) = pool->free;
+    pool->free = first;
+}
+
+/**
+ * @brief Hands the pool's whole region back to the memory manager at once,
+ * whatever number of nodes are still in use.
+ *
+ * @param pool A pointer to the node pool.
+ */
+static void node_pool_release(NodePool *pool) {
+    mem_free(pool->region);
+    pool->region = NULL;
+    pool->bump = pool->end = NULL;
+    pool->free = NULL;
+}
+
 /**
  * @brief Initializes the linked list.
  *
- * @param head A double pointer to the head of the linked list.
+ * @param list A pointer to the linked list.
  * @param size The size in bytes to allocate.
  */
-void list_init(Node **head, size_t size) {
-    mem_init(size);
-    *head = NULL;
+void list_init(List *list, size_t size) {
+    mem_init(size + NODE_POOL_SLACK);
+    list_attach(list, size);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes a linked list in a region of an already initialized
+ * memory manager, so any number of lists can share one pool. Cleaning the
+ * list up hands its region back without touching the other lists; the caller
+ * deinitializes the memory manager once they are all gone.
+ *
+ * @param list A pointer to the linked list.
+ * @param size The size in bytes to reserve for the list's nodes. The region
+ * takes NODE_POOL_SLACK bytes more.
+ */
+void list_attach(List *list, size_t size) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->index = NULL;
+    list->skip = NULL;
+    list->owns_pool = 0;
+    node_pool_init(&list->pool, size, sizeof(Node), offsetof(Node, next));
+    if (!list->pool.region)
+        printf_red("Memory allocation for the list failed!\n");
+}
+
+// ********* Sorted list *********
+
+/**
+ * @brief Draws the number of index levels for a new node: one more level with
+ * probability 1/4 each time.
+ *
+ * @param skip A pointer to the list's towers.
+ * @return The height, between 0 and LIST_SKIP_LEVELS.
+ */
+static int skip_height(ListSkip *skip) {
+    uint32_t x = skip->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    skip->seed = x;
+
+    int height = 0;
+    while (height < LIST_SKIP_LEVELS && (x & 3) == 0) {
+        height++;
+        x >>= 2;
+    }
+    return height;
+}
+
+/**
+ * @brief Descends the towers to the link pointing at the first node not
+ * ordered before `data`.
+ *
+ * @param list A pointer to the sorted list.
+ * @param data The data to search for.
+ * @param inclusive Whether nodes equal to `data` are ordered before it.
+ * @param preds If not NULL, set to the last index node before `data` on every
+ * level, or NULL where that is the level's head.
+ * @return The link.
+ */
+static Node **skip_find(List *list, uint16_t data, int inclusive,
+                        SkipIndex **preds) {
+    ListSkip *skip = list->skip;
+    SkipIndex *pred = NULL;
+    for (int level = skip->levels - 1; level >= 0; level--) {
+        SkipIndex *next = pred ? pred->right : skip->head[level];
+        while (next && (next->node->data < data ||
+                        (inclusive && next->node->data == data))) {
+            pred = next;
+            next = next->right;
+        }
+        if (preds) preds[level] = pred;
+        if (level > 0 && pred) pred = pred->down;
+    }
+
+    Node **link = pred ? &pred->node->next : &list->head;
+    while (*link &&
+           ((*link)->data < data || (inclusive && (*link)->data == data)))
+        link = &(*link)->next;
+    return link;
+}
+
+/**
+ * @brief Builds a tower for a node just linked in after `preds`. Running out
+ * of tower space only leaves the node without a tower.
+ *
+ * @param list A pointer to the sorted list.
+ * @param node The new node.
+ * @param preds The predecessors found by skip_find for the node's data.
+ */
+static void skip_insert(List *list, Node *node, SkipIndex **preds) {
+    ListSkip *skip = list->skip;
+    int height = skip_height(skip);
+    SkipIndex *below = NULL;
+    for (int level = 0; level < height; level++) {
+        SkipIndex *index = node_pool_alloc(&skip->pool);
+        if (!index) return;
+        if (level == skip->levels) {
+            preds[level] = NULL;
+            skip->levels++;
+        }
+        SkipIndex **link =
+            preds[level] ? &preds[level]->right : &skip->head[level];
+        index->node = node;
+        index->down = below;
+        index->right = *link;
+        *link = index;
+        below = index;
+    }
+}
+
+/**
+ * @brief Builds a tower for a node already linked in at a position chosen by
+ * the caller. Among nodes with the same data, the towers are kept in list
+ * order, as `skip_remove` expects.
+ *
+ * @param list A pointer to the sorted list.
+ * @param node The new node.
+ */
+static void skip_insert_linked(List *list, Node *node) {
+    ListSkip *skip = list->skip;
+    SkipIndex *preds[LIST_SKIP_LEVELS];
+    Node *run = *skip_find(list, node->data, 0, preds);
+
+    // Step past the towers of the equal nodes linked in before this one
+    for (; run != node; run = run->next)
+        for (int level = 0; level < skip->levels; level++) {
+            SkipIndex *next =
+                preds[level] ? preds[level]->right : skip->head[level];
+            if (!next || next->node != run) break;
+            preds[level] = next;
+        }
+    skip_insert(list, node, preds);
+}
+
+/**
+ * @brief Removes the tower of a node about to be unlinked.
+ *
+ * @param list A pointer to the sorted list.
+ * @param node The node being removed.
+ * @param preds The predecessors found by skip_find for the node's data.
+ */
+static void skip_remove(List *list, Node *node, SkipIndex **preds) {
+    ListSkip *skip = list->skip;
+    for (int level = 0; level < skip->levels; level++) {
+        SkipIndex **link =
+            preds[level] ? &preds[level]->right : &skip->head[level];
+        SkipIndex *index = *link;
+        if (!index || index->node != node) break;  // Towers have no gaps
+        *link = index->right;
+        node_pool_free(&skip->pool, index);
+    }
+    while (skip->levels > 0 && !skip->head[skip->levels - 1]) skip->levels--;
+}
+
+/**
+ * @brief Initializes a linked list kept in ascending order, with skip-list
+ * towers making insert, search and delete O(log n). The pool is grown by half
+ * of `size` for the towers.
+ *
+ * @param list A pointer to the linked list.
+ * @param size The size in bytes to allocate for the nodes.
+ */
+void list_init_sorted(List *list, size_t size) {
+    mem_init(sizeof(ListSkip) + size + size / 2 + 3 * NODE_POOL_SLACK);
+    list_attach_sorted(list, size);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes a sorted linked list in a region of an already
+ * initialized memory manager, like list_attach does for plain lists.
+ *
+ * @param list A pointer to the linked list.
+ * @param size The size in bytes to reserve for the nodes. The towers take
+ * sizeof(ListSkip) + size / 2 + 3 * NODE_POOL_SLACK bytes more.
+ */
+void list_attach_sorted(List *list, size_t size) {
+    void *block = mem_alloc_hinted(sizeof(ListSkip) + NODE_POOL_SLACK,
+                                   MEM_HINT_LONG_LIVED);
+    ListSkip *skip = block ? align_block(block) : NULL;
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->index = NULL;
+    list->skip = NULL;
+    list->owns_pool = 0;
+    node_pool_init(&list->pool, size, sizeof(Node), offsetof(Node, next));
+    if (!skip || !list->pool.region) {
+        printf_red("Memory allocation for the list failed!\n");
+        mem_free(block);
+        return;
+    }
+
+    for (int level = 0; level < LIST_SKIP_LEVELS; level++)
+        skip->head[level] = NULL;
+    skip->levels = 0;
+    skip->seed = 2463534242u;
+    skip->block = block;
+    node_pool_init(&skip->pool, size / 2, sizeof(SkipIndex),
+                   offsetof(SkipIndex, right));
+    list->skip = skip;
+}
+
+/**
+ * @brief Finds the first node of a sorted list not smaller than `data`.
+ *
+ * @param list A pointer to the sorted list.
+ * @param data The data to search for.
+ * @return A pointer to the node, or NULL if every node is smaller.
+ */
+Node *list_lower_bound(List *list, uint16_t data) {
+    if (!list->skip) {
+        printf_red("The list is not sorted!\n");
+        return NULL;
+    }
+    return *skip_find(list, data, 0, NULL);
+}
+
+/**
+ * @brief Prints the elements of a sorted list between two values (inclusive),
+ * locating both ends through the towers.
+ *
+ * @param list A pointer to the sorted list.
+ * @param low The smallest value to print.
+ * @param high The largest value to print.
+ */
+void list_display_values(List *list, uint16_t low, uint16_t high) {
+    if (!list->skip) {
+        printf_red("The list is not sorted!\n");
+        return;
+    }
+    Node *start_node = *skip_find(list, low, 0, NULL);
+    if (!start_node || low > high || start_node->data > high) {
+        printf("[]");
+        return;
+    }
+    // The link after the last node not larger than `high` belongs to it
+    list_display_range(list, start_node,
+                       NODE_OF_LINK(skip_find(list, high, 1, NULL)));
+}
+
+// ********* Value index *********
+
+/**
+ * @brief Records the node just linked in at `*link` in the value index.
+ *
+ * @param list A pointer to the linked list.
+ * @param link The link now pointing at the new node.
+ * @param maybe_first Whether the node may precede an existing node with the
+ * same value.
+ */
+static void index_insert(List *list, Node **link, int maybe_first) {
+    ListIndex *index = list->index;
+    Node *node = *link;
+
+    // The successor used to hang off `link`; it now hangs off the new node.
+    if (node->next && index->link[node->next->data] == link)
+        index->link[node->next->data] = &node->next;
+
+    if (index->count[node->data]++ == 0)
+        index->link[node->data] = link;
+    else if (maybe_first)
+        index->link[node->data] = NULL;
+}
+
+/**
+ * @brief Drops the node at `*link`, about to be unlinked, from the value
+ * index.
+ *
+ * @param list A pointer to the linked list.
+ * @param link The link pointing at the node being removed.
+ */
+static void index_remove(List *list, Node **link) {
+    ListIndex *index = list->index;
+    Node *node = *link;
+
+    // The successor will hang off `link` once the node is gone.
+    if (node->next && index->link[node->next->data] == &node->next)
+        index->link[node->next->data] = link;
+
+    // Removing the first occurrence leaves the next one unknown until needed.
+    if (--index->count[node->data] == 0 || index->link[node->data] == link)
+        index->link[node->data] = NULL;
+}
+
+/**
+ * @brief Finds the link pointing at the first node holding `data`.
+ *
+ * @param list A pointer to the linked list.
+ * @param data The data to search for.
+ * @return The link, or NULL if no node holds `data`.
+ */
+static Node **list_find_link(List *list, uint16_t data) {
+    ListIndex *index = list->index;
+    if (index) {
+        if (index->count[data] == 0) return NULL;
+        if (index->link[data]) return index->link[data];
+    }
+
+    Node **link = &list->head;
+    if (list->skip) {
+        link = skip_find(list, data, 0, NULL);
+        if (*link && (*link)->data != data) return NULL;
+    } else {
+        while (*link && (*link)->data != data) link = &(*link)->next;
+    }
+    if (!*link) return NULL;
+
+    if (index) index->link[data] = link;
+    return link;
+}
+
+/**
+ * @brief Enables the value index, making search and delete by value constant
+ * time at the cost of about 768 KiB per list.
+ *
+ * @param list A pointer to the linked list.
+ */
+void list_index_enable(List *list) {
+    if (list->index) return;
+
+    ListIndex *index = calloc(1, sizeof(ListIndex));
+    if (!index) {
+        printf_red("Memory allocation for the value index failed!\n");
+        return;
+    }
+    for (Node **link = &list->head; *link; link = &(*link)->next)
+        if (index->count[(*link)->data]++ == 0)
+            index->link[(*link)->data] = link;
+    list->index = index;
+}
+
+/**
+ * @brief Disables and frees the value index.
+ *
+ * @param list A pointer to the linked list.
+ */
+void list_index_disable(List *list) {
+    free(list->index);
+    list->index = NULL;
 }
 
+// ********* Linked list *********
+
 /**
- * @brief Inserts the specified data at the end of the linked list.
+ * @brief Inserts the specified data at the end of the linked list, or in
+ * order if the list is sorted.
  *
- * @param head A double pointer to the head of the linked list.
+ * @param list A pointer to the linked list.
  * @param data The data to insert into the linked list.
  */
-void list_insert(Node **head, uint16_t data) {
-    Node *new_node = mem_alloc(sizeof(Node));
+void list_insert(List *list, uint16_t data) {
+    Node *new_node = node_pool_alloc(&list->pool);
     if (!new_node) {
         printf_red("Memory allocation for insertion failed!\n");
         return;
     }
-    if (*head == NULL)
-        *head = new_node;
-    else {
-        Node *current = *head;
-        while (current->next != NULL) current = current->next;
-        current->next = new_node;
-    }
     new_node->data = data;
-    new_node->next = NULL;
+
+    SkipIndex *preds[LIST_SKIP_LEVELS];
+    Node **link = list->skip   ? skip_find(list, data, 0, preds)
+                  : list->tail ? &list->tail->next
+                               : &list->head;
+    new_node->next = *link;
+    *link = new_node;
+    if (!new_node->next) list->tail = new_node;
+    list->count++;
+    if (list->index) index_insert(list, link, list->skip != NULL);
+    if (list->skip) skip_insert(list, new_node, preds);
 }
 
 /**
  * @brief Inserts the specified data after the given node.
  *
+ * @param list A pointer to the linked list.
  * @param prev_node A pointer to the node to insert data after.
  * @param data The data to insert into the linked list.
  */
-void list_insert_after(Node *prev_node, uint16_t data) {
+void list_insert_after(List *list, Node *prev_node, uint16_t data) {
     if (!prev_node) {
         printf_red("Previous node is null!\n");
         return;
     }
     Node *next_node = prev_node->next;
-    Node *new_node = mem_alloc(sizeof(Node));
+    if (list->skip && (data < prev_node->data ||
+                       (next_node && data > next_node->data))) {
+        printf_red("Insertion would break the sorted order!\n");
+        return;
+    }
+    Node *new_node = node_pool_alloc(&list->pool);
     if (!new_node) {
         printf_red("Memory allocation for insertion after failed!\n");
         return;
@@ -54,19 +544,35 @@ void list_insert_after(Node *prev_node, uint16_t data) {
     new_node->data = data;
     prev_node->next = new_node;
     new_node->next = next_node;
+
+    if (list->tail == prev_node) list->tail = new_node;
+    list->count++;
+    if (list->index) index_insert(list, &prev_node->next, 1);
+    if (list->skip) skip_insert_linked(list, new_node);
 }
 
 /**
  * @brief Inserts the specified data before the given node.
  *
- * @param head A double pointer to the head of the linked list.
- * @param prev_node A pointer to the node to insert data before.
+ * @param list A pointer to the linked list.
+ * @param next_node A pointer to the node to insert data before.
  * @param data The data to insert into the linked list.
  */
-void list_insert_before(Node **head, Node *next_node, uint16_t data) {
-    if (*head == NULL || !next_node) return;
+void list_insert_before(List *list, Node *next_node, uint16_t data) {
+    if (list->head == NULL || !next_node) return;
+
+    // Find the link pointing at next_node before allocating anything.
+    Node **link = &list->head;
+    while (*link && *link != next_node) link = &(*link)->next;
+    if (!*link) return;
+    if (list->skip &&
+        (data > next_node->data ||
+         (link != &list->head && data < NODE_OF_LINK(link)->data))) {
+        printf_red("Insertion would break the sorted order!\n");
+        return;
+    }
 
-    Node *new_node = mem_alloc(sizeof(Node));
+    Node *new_node = node_pool_alloc(&list->pool);
     if (!new_node) {
         printf_red("Memory allocation for insertion before failed!\n");
         return;
@@ -74,123 +580,1773 @@ void list_insert_before(Node **head, Node *next_node, uint16_t data) {
 
     new_node->data = data;
     new_node->next = next_node;
+    *link = new_node;
+    list->count++;
+    if (list->index) index_insert(list, link, 1);
+    if (list->skip) skip_insert_linked(list, new_node);
+}
 
-    // If insert before the head node.
-    if (next_node == *head) {
-        *head = new_node;
-        return;
+/**
+ * @brief Removes a node with the specified data from the linked list.
+ *
+ * @param list A pointer to the linked list.
+ * @param data The data to remove from the linked list.
+ */
+void list_delete(List *list, uint16_t data) {
+    Node **link;
+    if (list->skip) {
+        SkipIndex *preds[LIST_SKIP_LEVELS];
+        link = skip_find(list, data, 0, preds);
+        if (!*link || (*link)->data != data) return;
+        skip_remove(list, *link, preds);
+    } else {
+        link = list_find_link(list, data);
+        if (!link) return;
     }
 
-    // Insert before a general node.
-    Node *current = *head;
-    while (current && current->next != next_node) current = current->next;
-    if (current) current->next = new_node;
+    Node *node = *link;
+    if (list->index) index_remove(list, link);
+    *link = node->next;
+    if (list->tail == node)
+        list->tail = link == &list->head ? NULL : NODE_OF_LINK(link);
+
+    list->count--;
+    node_pool_free(&list->pool, node);
 }
 
 /**
- * @brief Removes a node with the specified data from the linked list.
+ * @brief Removes every node whose data satisfies a predicate in a single
+ * traversal. The removed nodes go back to the pool as one chain.
  *
- * @param head A double pointer to the head of the linked list.
- * @param data The data to insert into the linked list.
+ * @param list A pointer to the linked list.
+ * @param predicate Called with each node's data and `ctx`; nonzero removes
+ * the node.
+ * @param ctx Passed through to the predicate.
+ * @return The number of nodes removed.
  */
-void list_delete(Node **head, uint16_t data) {
-    if (*head == NULL) return;
+size_t list_delete_if(List *list, ListPredicate predicate, void *ctx) {
+    // Towers are walked alongside the list: at[level] is the link to the
+    // first index node of that level not yet passed.
+    ListSkip *skip = list->skip;
+    int levels = skip ? skip->levels : 0;
+    SkipIndex **at[LIST_SKIP_LEVELS];
+    for (int level = 0; level < levels; level++) at[level] = &skip->head[level];
 
-    // If the data is on the first node.
-    if ((*head)->data == data) {
-        Node *temp = *head;
-        *head = temp->next;
-        mem_free(temp);
-        return;
+    Node *freed = NULL;
+    Node **freed_link = &freed;
+    size_t removed = 0;
+    Node **link = &list->head;
+    while (*link) {
+        Node *node = *link;
+        int drop = predicate(node->data, ctx);
+        for (int level = 0;
+             level < levels && *at[level] && (*at[level])->node == node;
+             level++) {
+            SkipIndex *index = *at[level];
+            if (drop) {
+                *at[level] = index->right;
+                node_pool_free(&skip->pool, index);
+            } else {
+                at[level] = &index->right;
+            }
+        }
+        if (!drop) {
+            link = &node->next;
+            continue;
+        }
+
+        if (list->index) index_remove(list, link);
+        *link = node->next;
+        *freed_link = node;
+        freed_link = &node->next;
+        removed++;
     }
+    if (!removed) return 0;
 
-    // If the data is on a general node.
-    Node *current = *head;
-    while (current->next) {
-        if (current->next->data == data) {
-            Node *temp = current->next;
-            current->next = temp->next;
-            mem_free(temp);
-            return;
-        }
-        current = current->next;
+    list->tail = link == &list->head ? NULL : NODE_OF_LINK(link);
+    list->count -= removed;
+    if (skip)
+        while (skip->levels > 0 && !skip->head[skip->levels - 1])
+            skip->levels--;
+    node_pool_free_chain(&list->pool, freed, NODE_OF_LINK(freed_link));
+    return removed;
+}
+
+/**
+ * @brief Predicate matching the value `ctx` points at.
+ */
+static int data_equals(uint16_t data, void *ctx) {
+    return data == *(uint16_t *)ctx;
+}
+
+/**
+ * @brief Removes every node with the specified data in a single traversal,
+ * or in O(log n) plus the number of matches if the list is sorted.
+ *
+ * @param list A pointer to the linked list.
+ * @param data The data to remove from the linked list.
+ * @return The number of nodes removed.
+ */
+size_t list_delete_all(List *list, uint16_t data) {
+    if (!list->skip) return list_delete_if(list, data_equals, &data);
+
+    // Equal nodes sit together, and the predecessors stay valid for all.
+    SkipIndex *preds[LIST_SKIP_LEVELS];
+    Node **link = skip_find(list, data, 0, preds);
+    Node *first = *link, *last = NULL;
+    size_t removed = 0;
+    while (*link && (*link)->data == data) {
+        last = *link;
+        skip_remove(list, last, preds);
+        if (list->index) index_remove(list, link);
+        *link = last->next;
+        removed++;
     }
+    if (!removed) return 0;
+
+    if (!*link) list->tail = link == &list->head ? NULL : NODE_OF_LINK(link);
+    list->count -= removed;
+    node_pool_free_chain(&list->pool, first, last);
+    return removed;
 }
 
 /**
  * @brief Searches for a node with the specified data and returns a pointer to
  * it.
  *
- * @param head A double pointer to the head of the linked list.
- * @param data The data to insert into the linked list.
+ * @param list A pointer to the linked list.
+ * @param data The data to search for.
  * @return A pointer to the returned node.
  */
-Node *list_search(Node **head, uint16_t data) {
-    Node *current = *head;
-    while (current) {
-        if (current->data == data) return current;
-        current = current->next;
+Node *list_search(List *list, uint16_t data) {
+    Node **link = list_find_link(list, data);
+    return link ? *link : NULL;
+}
+
+/**
+ * @brief Appends every value of an array to the linked list, or inserts them
+ * in order if the list is sorted. Nodes are carved from the pool as one
+ * contiguous run where possible and linked in a single pass.
+ *
+ * @param list A pointer to the linked list.
+ * @param values The values to append.
+ * @param count The number of values.
+ * @return The number of values appended, less than `count` only if the pool
+ * ran out.
+ */
+size_t list_append_array(List *list, const uint16_t *values, size_t count) {
+    size_t done = 0;
+    if (list->skip) {
+        for (; done < count; done++) {
+            size_t before = list->count;
+            list_insert(list, values[done]);
+            if (list->count == before) break;
+        }
+        return done;
     }
-    return NULL;
+
+    Node **start = list->tail ? &list->tail->next : &list->head;
+    Node **link = start;
+    while (done < count) {
+        size_t run = count - done;
+        Node *nodes = node_pool_alloc_run(&list->pool, &run);
+        if (!run) {
+            // No fresh space left: fall back to nodes freed earlier
+            nodes = node_pool_alloc(&list->pool);
+            if (!nodes) {
+                printf_red("Memory allocation for appending failed!\n");
+                break;
+            }
+            run = 1;
+        }
+        for (size_t i = 0; i < run; i++) {
+            nodes[i].data = values[done + i];
+            nodes[i].next = &nodes[i + 1];
+        }
+        *link = nodes;
+        link = &nodes[run - 1].next;
+        done += run;
+    }
+    *link = NULL;
+    if (!done) return 0;
+
+    list->tail = NODE_OF_LINK(link);
+    list->count += done;
+    if (list->index)
+        for (; *start; start = &(*start)->next) index_insert(list, start, 0);
+    return done;
 }
 
 /**
- * @brief Prints all elements of the list.
+ * @brief Initializes a linked list holding the values of an array, with a
+ * pool or, if `attach` is set, a region of the current pool just large enough
+ * for them.
  *
- * @param head A double pointer to the head of the list.
+ * @param list A pointer to the linked list.
+ * @param values The values to store.
+ * @param count The number of values.
+ * @param attach Whether to use `list_attach` rather than `list_init`.
  */
-void list_display(Node **head) { list_display_range(head, NULL, NULL); }
+static void list_from_array_as(List *list, const uint16_t *values,
+                               size_t count, int attach) {
+    if (attach)
+        list_attach(list, sizeof(Node) * count);
+    else
+        list_init(list, sizeof(Node) * count);
+    list_append_array(list, values, count);
+}
 
 /**
- * @brief Prints all elements of the list between two nodes (inclusive).
+ * @brief Initializes a linked list holding the values of an array, with a
+ * new pool just large enough for them. Any existing pool is discarded.
  *
- * @param head A double pointer to the head of the linked list.
- * @param start_node A pointer to the start node (NULL for start of linked
- * list).
- * @param end_node A pointer to the end node (NULL for end of linked list).
+ * @param list A pointer to the linked list.
+ * @param values The values to store.
+ * @param count The number of values.
  */
-void list_display_range(Node **head, Node *start_node, Node *end_node) {
-    printf("[");
-    if (!start_node) start_node = *head;
-    if (end_node) end_node = end_node->next;
-    while (start_node && start_node != end_node) {
-        printf("%d", start_node->data);
-        start_node = start_node->next;
-        if (start_node && start_node != end_node) printf(", ");
-    }
-    printf("]");
+void list_from_array(List *list, const uint16_t *values, size_t count) {
+    list_from_array_as(list, values, count, 0);
 }
 
 /**
- * @brief Counts the number of nodes in the linked list.
+ * @brief Initializes a linked list holding the values of an array in a region
+ * of the already initialized memory manager, like `list_attach`.
  *
- * @param head A double pointer to the head of the linked list.
- * @return The number of nodes in the linked list.
+ * @param list A pointer to the linked list.
+ * @param values The values to store.
+ * @param count The number of values.
  */
-int list_count_nodes(Node **head) {
-    if (*head == NULL) return 0;
-    int count = 0;
+void list_from_array_attached(List *list, const uint16_t *values,
+                              size_t count) {
+    list_from_array_as(list, values, count, 1);
+}
 
-    Node *current = *head;
-    while (current) {
-        count++;
-        current = current->next;
-    }
+/**
+ * @brief Copies the values of the linked list, in order, into an array.
+ *
+ * @param list A pointer to the linked list.
+ * @param values The array to fill.
+ * @param capacity The number of values the array can hold.
+ * @return The number of values copied.
+ */
+size_t list_to_array(List *list, uint16_t *values, size_t capacity) {
+    size_t count = 0;
+    for (Node *node = list->head; node && count < capacity; node = node->next)
+        values[count++] = node->data;
     return count;
 }
 
 /**
- * @brief Frees all the nodes in the linked list.
+ * @brief Moves the nodes of the linked list to the start of its region in
+ * traversal order, so walking the list reads memory sequentially again.
+ * Every node pointer held outside the list is invalidated; translate them
+ * with `remap`.
  *
- * @param head A double pointer to the head of the linked list.
+ * @param list A pointer to the linked list.
+ * @param remap If not NULL, filled with where each node went. Free it with
+ * list_remap_free.
  */
-void list_cleanup(Node **head) {
-    Node *current = *head;
-    while (current) {
-        Node *temp = current;
-        current = current->next;
-        mem_free(temp);
+void list_compact(List *list, ListRemap *remap) {
+    NodePool *pool = &list->pool;
+    if (!pool->region) return;
+    Node *base = node_pool_first(pool);
+    size_t slots = (Node *)pool->bump - base;
+    size_t count = list->count;
+
+    uint32_t *slot = malloc(slots * sizeof(uint32_t));
+    uint16_t *values = malloc(count * sizeof(uint16_t));
+    if ((slots && !slot) || (count && !values)) {
+        printf_red("Memory allocation for compaction failed!\n");
+        free(slot);
+        free(values);
+        return;
+    }
+
+    // Record the traversal order, then rewrite the nodes in that order
+    for (size_t i = 0; i < slots; i++) slot[i] = LIST_REMAP_NONE;
+    size_t i = 0;
+    for (Node *node = list->head; node; node = node->next, i++) {
+        slot[node - base] = i;
+        values[i] = node->data;
+    }
+    for (i = 0; i < count; i++) {
+        base[i].data = values[i];
+        base[i].next = i + 1 < count ? &base[i + 1] : NULL;
+    }
+    free(values);
+
+    list->head = count ? base : NULL;
+    list->tail = count ? &base[count - 1] : NULL;
+    pool->bump = (char *)&base[count];
+    pool->free = NULL;
+
+    if (list->skip)
+        for (int level = 0; level < list->skip->levels; level++)
+            for (SkipIndex *index = list->skip->head[level]; index;
+                 index = index->right)
+                index->node = &base[slot[index->node - base]];
+    if (list->index) {
+        list_index_disable(list);
+        list_index_enable(list);
+    }
+
+    if (remap) {
+        remap->base = base;
+        remap->slots = slots;
+        remap->slot = slot;
+    } else {
+        free(slot);
+    }
+}
+
+/**
+ * @brief Translates a node pointer taken before list_compact.
+ *
+ * @param remap The remap filled by list_compact.
+ * @param node A node pointer from before the compaction.
+ * @return Where the node now lives, or NULL if it was not in the list.
+ */
+Node *list_remap(ListRemap *remap, Node *node) {
+    if (node < remap->base || node >= remap->base + remap->slots) return NULL;
+    uint32_t slot = remap->slot[node - remap->base];
+    return slot == LIST_REMAP_NONE ? NULL : &remap->base[slot];
+}
+
+/**
+ * @brief Frees a remap filled by list_compact.
+ *
+ * @param remap The remap.
+ */
+void list_remap_free(ListRemap *remap) {
+    free(remap->slot);
+    remap->slot = NULL;
+    remap->slots = 0;
+}
+
+/**
+ * @brief Starts a batched traversal of the linked list.
+ *
+ * @param iter A pointer to the iterator.
+ * @param list A pointer to the linked list.
+ */
+void list_iter_init(ListIter *iter, List *list) {
+    iter->node = list->head;
+    iter->ahead = list->head;
+    for (int i = 0; i < LIST_PREFETCH_DISTANCE && iter->ahead; i++) {
+        __builtin_prefetch(iter->ahead->next);
+        iter->ahead = iter->ahead->next;
     }
-    *head = NULL;
-    mem_deinit();
+}
+
+/**
+ * @brief Reads the next batch of values into `iter->values`.
+ *
+ * @param iter A pointer to the iterator.
+ * @return The number of values read, 0 once the list is exhausted.
+ */
+size_t list_iter_next(ListIter *iter) {
+    Node *node = iter->node;
+    Node *ahead = iter->ahead;
+    size_t count = 0;
+    while (node && count < LIST_BATCH) {
+        iter->values[count++] = node->data;
+        node = node->next;
+        if (ahead) {
+            __builtin_prefetch(ahead->next);
+            ahead = ahead->next;
+        }
+    }
+    iter->node = node;
+    iter->ahead = ahead;
+    return count;
+}
+
+/**
+ * @brief Calls `visitor` with every value of the linked list, in order and
+ * in batches of up to LIST_BATCH values.
+ *
+ * @param list A pointer to the linked list.
+ * @param visitor Called with each batch and `ctx`.
+ * @param ctx Passed through to the visitor.
+ */
+void list_visit(List *list, ListVisitor visitor, void *ctx) {
+    ListIter iter;
+    list_iter_init(&iter, list);
+    size_t count;
+    while ((count = list_iter_next(&iter))) visitor(iter.values, count, ctx);
+}
+
+/**
+ * @brief Prints all elements of the list.
+ *
+ * @param list A pointer to the list.
+ */
+void list_display(List *list) { list_display_range(list, NULL, NULL); }
+
+/**
+ * @brief Prints all elements of the list between two nodes (inclusive).
+ *
+ * @param list A pointer to the linked list.
+ * @param start_node A pointer to the start node (NULL for start of linked
+ * list).
+ * @param end_node A pointer to the end node (NULL for end of linked list).
+ */
+void list_display_range(List *list, Node *start_node, Node *end_node) {
+    list_display_range_to(list, start_node, end_node, stdout);
+}
+
+// Display output is formatted into this buffer and written in large chunks,
+// to a stream if one is set and to the file descriptor otherwise.
+#define LIST_WRITE_BUFFER 16384
+
+typedef struct ListWriter {
+    FILE *stream;
+    int fd;
+    int failed;
+    size_t used;
+    char buffer[LIST_WRITE_BUFFER];
+} ListWriter;
+
+/**
+ * @brief Writes out and empties the writer's buffer.
+ *
+ * @param writer A pointer to the writer.
+ */
+static void writer_flush(ListWriter *writer) {
+    if (writer->stream) {
+        if (fwrite(writer->buffer, 1, writer->used, writer->stream) !=
+            writer->used)
+            writer->failed = 1;
+    } else {
+        size_t done = 0;
+        while (done < writer->used) {
+            ssize_t written =
+                write(writer->fd, writer->buffer + done, writer->used - done);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                printf_red("Writing the list failed!\n");
+                writer->failed = 1;
+                break;
+            }
+            done += written;
+        }
+    }
+    writer->used = 0;
+}
+
+/**
+ * @brief Formats a value in decimal without going through printf.
+ *
+ * @param out Where to write the digits, at least 5 bytes.
+ * @param value The value to format.
+ * @return The number of digits written.
+ */
+static int format_u16(char *out, uint16_t value) {
+    char digits[5];
+    int count = 0;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    for (int i = 0; i < count; i++) out[i] = digits[count - 1 - i];
+    return count;
+}
+
+/**
+ * @brief Writes the elements between two nodes (inclusive) in display format
+ * and flushes the writer.
+ *
+ * @param writer A pointer to the writer.
+ * @param list A pointer to the linked list.
+ * @param start_node The start node, NULL for the head.
+ * @param end_node The end node, NULL for the tail.
+ */
+static void writer_range(ListWriter *writer, List *list, Node *start_node,
+                         Node *end_node) {
+    writer->buffer[writer->used++] = '[';
+    if (!start_node) start_node = list->head;
+    if (end_node) end_node = end_node->next;
+    for (Node *node = start_node; node && node != end_node; node = node->next) {
+        // Room for a separator, five digits and the closing bracket
+        if (LIST_WRITE_BUFFER - writer->used < 8) writer_flush(writer);
+        char *out = writer->buffer + writer->used;
+        if (node != start_node) {
+            *out++ = ',';
+            *out++ = ' ';
+        }
+        out += format_u16(out, node->data);
+        writer->used = out - writer->buffer;
+    }
+    writer->buffer[writer->used++] = ']';
+    writer_flush(writer);
+}
+
+/**
+ * @brief Writes all elements of the list between two nodes (inclusive) to a
+ * stream, in large buffered chunks.
+ *
+ * @param list A pointer to the linked list.
+ * @param start_node A pointer to the start node (NULL for start of linked
+ * list).
+ * @param end_node A pointer to the end node (NULL for end of linked list).
+ * @param stream The stream to write to.
+ */
+void list_display_range_to(List *list, Node *start_node, Node *end_node,
+                           FILE *stream) {
+    ListWriter writer;
+    writer.stream = stream;
+    writer.failed = 0;
+    writer.used = 0;
+    writer_range(&writer, list, start_node, end_node);
+}
+
+/**
+ * @brief Writes all elements of the list between two nodes (inclusive) to a
+ * file descriptor, bypassing stdio.
+ *
+ * @param list A pointer to the linked list.
+ * @param start_node A pointer to the start node (NULL for start of linked
+ * list).
+ * @param end_node A pointer to the end node (NULL for end of linked list).
+ * @param fd The file descriptor to write to.
+ */
+void list_display_range_fd(List *list, Node *start_node, Node *end_node,
+                           int fd) {
+    ListWriter writer;
+    writer.stream = NULL;
+    writer.fd = fd;
+    writer.failed = 0;
+    writer.used = 0;
+    writer_range(&writer, list, start_node, end_node);
+}
+
+/**
+ * @brief Counts the number of nodes in the linked list.
+ *
+ * @param list A pointer to the linked list.
+ * @return The number of nodes in the linked list.
+ */
+int list_count_nodes(List *list) { return list->count; }
+
+/**
+ * @brief Frees all the nodes in the linked list in constant time by
+ * releasing the region they live in.
+ *
+ * @param list A pointer to the linked list.
+ */
+void list_cleanup(List *list) {
+    if (list->skip) {
+        node_pool_release(&list->skip->pool);
+        mem_free(list->skip->block);
+        list->skip = NULL;
+    }
+    node_pool_release(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list_index_disable(list);
+    if (list->owns_pool) mem_deinit();
+}
+
+// ********* Serialization *********
+
+#define LIST_FILE_MAGIC "LLST"
+#define LIST_FILE_VERSION 1
+#define LIST_FILE_HEADER 16
+
+/**
+ * @brief Writes an unsigned value to `out` as `bytes` little-endian bytes.
+ */
+static void put_le(unsigned char *out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[i] = value >> (8 * i);
+}
+
+/**
+ * @brief Reads `bytes` little-endian bytes from `in`.
+ */
+static uint64_t get_le(const unsigned char *in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+/**
+ * @brief Saves the linked list to a file in the binary list format.
+ *
+ * @param list A pointer to the linked list.
+ * @param path The file to create or overwrite.
+ * @param encoding LIST_ENCODING_DELTA packs lists whose neighbouring values
+ * are close, sorted ones in particular, into about a byte per value.
+ * @return Whether the list was saved.
+ */
+int list_save(List *list, const char *path, ListEncoding encoding) {
+    ListWriter writer;
+    writer.stream = NULL;
+    writer.failed = 0;
+    writer.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer.fd < 0) {
+        printf_red("Opening %s for saving failed!\n", path);
+        return 0;
+    }
+
+    unsigned char *out = (unsigned char *)writer.buffer;
+    memcpy(out, LIST_FILE_MAGIC, 4);
+    put_le(out + 4, LIST_FILE_VERSION, 2);
+    put_le(out + 6, encoding, 2);
+    put_le(out + 8, list->count, 8);
+    writer.used = LIST_FILE_HEADER;
+
+    uint16_t prev = 0;
+    for (Node *node = list->head; node; node = node->next) {
+        // A zigzag varint of a 17-bit difference takes at most 3 bytes
+        if (LIST_WRITE_BUFFER - writer.used < 3) writer_flush(&writer);
+        out = (unsigned char *)writer.buffer + writer.used;
+        if (encoding == LIST_ENCODING_RAW) {
+            put_le(out, node->data, 2);
+            writer.used += 2;
+            continue;
+        }
+        int32_t diff = (int32_t)node->data - prev;
+        uint32_t zigzag = ((uint32_t)diff << 1) ^ (uint32_t)(diff >> 31);
+        while (zigzag >= 0x80) {
+            *out++ = zigzag | 0x80;
+            zigzag >>= 7;
+        }
+        *out++ = zigzag;
+        writer.used = (char *)out - writer.buffer;
+        prev = node->data;
+    }
+    writer_flush(&writer);
+    return close(writer.fd) == 0 && !writer.failed;
+}
+
+/**
+ * @brief Initializes a linked list from a file written by list_save. The file
+ * is mapped and decoded straight into one contiguous run of nodes.
+ *
+ * @param list A pointer to the linked list, initialized only on success.
+ * @param path The file to load.
+ * @param attach Whether to use `list_attach` rather than `list_init`.
+ * @return Whether the list was loaded.
+ */
+static int list_load_as(List *list, const char *path, int attach) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        printf_red("Opening %s for loading failed!\n", path);
+        if (fd >= 0) close(fd);
+        return 0;
+    }
+    size_t size = st.st_size;
+    const unsigned char *data =
+        size ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (data == MAP_FAILED || size < LIST_FILE_HEADER ||
+        memcmp(data, LIST_FILE_MAGIC, 4) != 0 ||
+        get_le(data + 4, 2) != LIST_FILE_VERSION) {
+        printf_red("%s is not a saved list!\n", path);
+        if (data != MAP_FAILED) munmap((void *)data, size);
+        return 0;
+    }
+
+    ListEncoding encoding = get_le(data + 6, 2);
+    uint64_t count = get_le(data + 8, 8);
+    const unsigned char *in = data + LIST_FILE_HEADER;
+    const unsigned char *end = data + size;
+    if ((encoding != LIST_ENCODING_RAW && encoding != LIST_ENCODING_DELTA) ||
+        (encoding == LIST_ENCODING_RAW && (size_t)(end - in) != count * 2) ||
+        (encoding == LIST_ENCODING_DELTA && (size_t)(end - in) < count)) {
+        printf_red("%s is corrupt!\n", path);
+        munmap((void *)data, size);
+        return 0;
+    }
+
+    if (attach)
+        list_attach(list, sizeof(Node) * (count ? count : 1));
+    else
+        list_init(list, sizeof(Node) * (count ? count : 1));
+    size_t run = count;
+    Node *nodes = node_pool_alloc_run(&list->pool, &run);
+    if (run != count) {
+        printf_red("Memory allocation for loading %s failed!\n", path);
+        munmap((void *)data, size);
+        list_cleanup(list);
+        return 0;
+    }
+
+    int valid = 1;
+    uint16_t prev = 0;
+    for (size_t i = 0; valid && i < count; i++) {
+        if (encoding == LIST_ENCODING_RAW) {
+            nodes[i].data = get_le(in, 2);
+            in += 2;
+        } else {
+            uint32_t zigzag = 0;
+            int shift = 0;
+            do {
+                if (in == end || shift > 14) {
+                    valid = 0;
+                    break;
+                }
+                zigzag |= (uint32_t)(*in & 0x7f) << shift;
+                shift += 7;
+            } while (*in++ & 0x80);
+            prev += (zigzag >> 1) ^ -(zigzag & 1);
+            nodes[i].data = prev;
+        }
+        nodes[i].next = &nodes[i + 1];
+    }
+    munmap((void *)data, size);
+    if (!valid) {
+        printf_red("%s is corrupt!\n", path);
+        list_cleanup(list);
+        return 0;
+    }
+
+    if (count) {
+        nodes[count - 1].next = NULL;
+        list->head = nodes;
+        list->tail = &nodes[count - 1];
+        list->count = count;
+    }
+    return 1;
+}
+
+/**
+ * @brief Initializes a linked list from a file written by list_save, with a
+ * new pool. Any existing pool is discarded.
+ *
+ * @param list A pointer to the linked list, initialized only on success.
+ * @param path The file to load.
+ * @return Whether the list was loaded.
+ */
+int list_load(List *list, const char *path) {
+    return list_load_as(list, path, 0);
+}
+
+/**
+ * @brief Initializes a linked list from a file written by list_save in a
+ * region of the already initialized memory manager, like `list_attach`.
+ *
+ * @param list A pointer to the linked list, initialized only on success.
+ * @param path The file to load.
+ * @return Whether the list was loaded.
+ */
+int list_load_attached(List *list, const char *path) {
+    return list_load_as(list, path, 1);
+}
+
+// ********* Doubly linked list *********
+
+/**
+ * @brief Initializes the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param size The size in bytes to allocate.
+ */
+void dlist_init(DList *list, size_t size) {
+    mem_init(size + NODE_POOL_SLACK);
+    dlist_attach(list, size);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes the doubly linked list in a region of an already
+ * initialized memory manager, like list_attach does for plain lists.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param size The size in bytes to reserve for the list's nodes. The region
+ * takes NODE_POOL_SLACK bytes more.
+ */
+void dlist_attach(DList *list, size_t size) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->owns_pool = 0;
+    node_pool_init(&list->pool, size, sizeof(DNode), offsetof(DNode, next));
+    if (!list->pool.region)
+        printf_red("Memory allocation for the list failed!\n");
+}
+
+/**
+ * @brief Links a new node holding `data` between `prev_node` and `next_node`,
+ * either of which may be NULL at the ends of the list.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param prev_node The node before the new node.
+ * @param next_node The node after the new node.
+ * @param data The data to insert.
+ * @return Whether the node could be allocated.
+ */
+static int dlist_link(DList *list, DNode *prev_node, DNode *next_node,
+                      uint16_t data) {
+    DNode *new_node = node_pool_alloc(&list->pool);
+    if (!new_node) return 0;
+    new_node->data = data;
+    new_node->prev = prev_node;
+    new_node->next = next_node;
+
+    if (prev_node)
+        prev_node->next = new_node;
+    else
+        list->head = new_node;
+    if (next_node)
+        next_node->prev = new_node;
+    else
+        list->tail = new_node;
+    list->count++;
+    return 1;
+}
+
+/**
+ * @brief Inserts the specified data at the end of the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param data The data to insert into the list.
+ */
+void dlist_insert(DList *list, uint16_t data) {
+    if (!dlist_link(list, list->tail, NULL, data))
+        printf_red("Memory allocation for insertion failed!\n");
+}
+
+/**
+ * @brief Inserts the specified data after the given node.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param prev_node A pointer to the node to insert data after.
+ * @param data The data to insert into the list.
+ */
+void dlist_insert_after(DList *list, DNode *prev_node, uint16_t data) {
+    if (!prev_node) {
+        printf_red("Previous node is null!\n");
+        return;
+    }
+    if (!dlist_link(list, prev_node, prev_node->next, data))
+        printf_red("Memory allocation for insertion after failed!\n");
+}
+
+/**
+ * @brief Inserts the specified data before the given node in constant time.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param next_node A pointer to the node to insert data before.
+ * @param data The data to insert into the list.
+ */
+void dlist_insert_before(DList *list, DNode *next_node, uint16_t data) {
+    if (!next_node) return;
+    if (!dlist_link(list, next_node->prev, next_node, data))
+        printf_red("Memory allocation for insertion before failed!\n");
+}
+
+/**
+ * @brief Removes the given node from the doubly linked list in constant time.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param node A pointer to the node to remove.
+ */
+void dlist_remove_node(DList *list, DNode *node) {
+    if (!node) return;
+
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+
+    list->count--;
+    node_pool_free(&list->pool, node);
+}
+
+/**
+ * @brief Removes a node with the specified data from the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param data The data to remove from the list.
+ */
+void dlist_delete(DList *list, uint16_t data) {
+    dlist_remove_node(list, dlist_search(list, data));
+}
+
+/**
+ * @brief Searches for a node with the specified data.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param data The data to search for.
+ * @return A pointer to the node, or NULL if it is not in the list.
+ */
+DNode *dlist_search(DList *list, uint16_t data) {
+    DNode *current = list->head;
+    while (current && current->data != data) current = current->next;
+    return current;
+}
+
+/**
+ * @brief Prints all elements of the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ */
+void dlist_display(DList *list) { dlist_display_range(list, NULL, NULL); }
+
+/**
+ * @brief Prints all elements of the doubly linked list between two nodes
+ * (inclusive).
+ *
+ * @param list A pointer to the doubly linked list.
+ * @param start_node A pointer to the start node (NULL for start of the list).
+ * @param end_node A pointer to the end node (NULL for end of the list).
+ */
+void dlist_display_range(DList *list, DNode *start_node, DNode *end_node) {
+    printf("[");
+    if (!start_node) start_node = list->head;
+    if (end_node) end_node = end_node->next;
+    while (start_node && start_node != end_node) {
+        printf("%d", start_node->data);
+        start_node = start_node->next;
+        if (start_node && start_node != end_node) printf(", ");
+    }
+    printf("]");
+}
+
+/**
+ * @brief Counts the number of nodes in the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ * @return The number of nodes in the list.
+ */
+int dlist_count(DList *list) { return list->count; }
+
+/**
+ * @brief Frees all the nodes in the doubly linked list.
+ *
+ * @param list A pointer to the doubly linked list.
+ */
+void dlist_cleanup(DList *list) {
+    node_pool_release(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    if (list->owns_pool) mem_deinit();
+}
+
+// ********* Concurrent linked list *********
+
+#define CONC_MARK ((uintptr_t)1)
+#define CONC_PTR(link) ((ConcNode *)((link) & ~CONC_MARK))
+#define CONC_BATCH 32         // Nodes a thread takes from the pool at once
+#define CONC_ADVANCE_EVERY 64  // Retirements between epoch advance attempts
+#define CONC_RECLAIM_TRIES 64  // Epoch advances tried before an insert fails
+
+/**
+ * @brief Initializes the concurrent list.
+ *
+ * @param list A pointer to the concurrent list.
+ * @param size The size in bytes to allocate.
+ */
+void conclist_init(ConcList *list, size_t size) {
+    mem_init(size + NODE_POOL_SLACK);
+    conclist_init_attached(list, size);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes the concurrent list in a region of an already
+ * initialized memory manager, like list_attach does for plain lists.
+ *
+ * @param list A pointer to the concurrent list.
+ * @param size The size in bytes to reserve for the list's nodes. The region
+ * takes NODE_POOL_SLACK bytes more.
+ */
+void conclist_init_attached(ConcList *list, size_t size) {
+    list->head.data = 0;
+    atomic_init(&list->head.next, 0);
+    atomic_init(&list->epoch, 1);
+    for (int i = 0; i < 3; i++) atomic_init(&list->retired[i], NULL);
+    atomic_init(&list->thread_count, 0);
+    atomic_init(&list->count, 0);
+    pthread_mutex_init(&list->pool_lock, NULL);
+    list->owns_pool = 0;
+    node_pool_init(&list->pool, size, sizeof(ConcNode),
+                   offsetof(ConcNode, free_next));
+    if (!list->pool.region)
+        printf_red("Memory allocation for the list failed!\n");
+}
+
+/**
+ * @brief Registers the calling thread with the concurrent list.
+ *
+ * @param list A pointer to the concurrent list.
+ * @return The thread's record, or NULL if CONC_MAX_THREADS are attached.
+ */
+ConcThread *conclist_attach(ConcList *list) {
+    int slot = atomic_fetch_add(&list->thread_count, 1);
+    if (slot >= CONC_MAX_THREADS) {
+        printf_red("Too many threads attached to the concurrent list!\n");
+        return NULL;
+    }
+    ConcThread *self = &list->threads[slot];
+    atomic_init(&self->active, 0);
+    atomic_init(&self->epoch, 0);
+    self->free = NULL;
+    self->retired_count = 0;
+    return self;
+}
+
+/**
+ * @brief Enters a read-side critical section.
+ */
+static void conc_enter(ConcList *list, ConcThread *self) {
+    atomic_store(&self->active, 1);
+    atomic_store(&self->epoch, atomic_load(&list->epoch));
+}
+
+/**
+ * @brief Leaves a read-side critical section.
+ */
+static void conc_exit(ConcThread *self) {
+    atomic_store_explicit(&self->active, 0, memory_order_release);
+}
+
+/**
+ * @brief Moves the global epoch forward if every active thread has observed
+ * it.
+ */
+static void conc_try_advance(ConcList *list) {
+    unsigned long epoch = atomic_load(&list->epoch);
+    int threads = atomic_load(&list->thread_count);
+    if (threads > CONC_MAX_THREADS) threads = CONC_MAX_THREADS;
+    for (int i = 0; i < threads; i++) {
+        ConcThread *other = &list->threads[i];
+        if (atomic_load(&other->active) && atomic_load(&other->epoch) != epoch)
+            return;
+    }
+    if (!atomic_compare_exchange_strong(&list->epoch, &epoch, epoch + 1))
+        return;
+
+    // Nodes retired when the global epoch was epoch - 1 can no longer be
+    // reached by any thread still in its critical section, and no thread
+    // retires into their bucket any more. Whichever thread retired them, they
+    // go straight back to the shared pool.
+    ConcNode *first = atomic_exchange(&list->retired[(epoch + 2) % 3], NULL);
+    if (!first) return;
+    ConcNode *last = first;
+    while (last->free_next) last = last->free_next;
+    pthread_mutex_lock(&list->pool_lock);
+    node_pool_free_chain(&list->pool, first, last);
+    pthread_mutex_unlock(&list->pool_lock);
+}
+
+/**
+ * @brief Queues a node this thread unlinked for reclamation.
+ */
+static void conc_retire(ConcList *list, ConcThread *self, ConcNode *node) {
+    _Atomic(ConcNode *) *bucket =
+        &list->retired[atomic_load(&list->epoch) % 3];
+    node->free_next = atomic_load_explicit(bucket, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak(bucket, &node->free_next, node))
+        ;
+    if (++self->retired_count % CONC_ADVANCE_EVERY == 0) conc_try_advance(list);
+}
+
+/**
+ * @brief Takes a node from the thread's own free chain, refilling it from the
+ * shared pool in batches. With the pool empty too, the epoch is pushed
+ * forward so retired nodes flow back into the pool. Must be called right
+ * after `conc_enter`, before the thread holds any node.
+ */
+static ConcNode *conc_new_node(ConcList *list, ConcThread *self) {
+    for (int tries = 0; !self->free; tries++) {
+        pthread_mutex_lock(&list->pool_lock);
+        for (int i = 0; i < CONC_BATCH; i++) {
+            ConcNode *node = node_pool_alloc(&list->pool);
+            if (!node) break;
+            node->free_next = self->free;
+            self->free = node;
+        }
+        pthread_mutex_unlock(&list->pool_lock);
+        if (self->free) break;
+        if (tries == CONC_RECLAIM_TRIES) return NULL;
+
+        // Holding no nodes yet, the thread can step out of its critical
+        // section so the epoch can move, then collect what it frees
+        conc_exit(self);
+        conc_try_advance(list);
+        sched_yield();
+        conc_enter(list, self);
+    }
+    ConcNode *node = self->free;
+    self->free = node->free_next;
+    return node;
+}
+
+/**
+ * @brief Finds the first unmarked node not smaller than `data`, unlinking any
+ * marked nodes on the way.
+ *
+ * @param prev Set to the link pointing at the returned node.
+ * @return The node, or NULL if every node is smaller than `data`.
+ */
+static ConcNode *conc_find(ConcList *list, ConcThread *self, uint16_t data,
+                           _Atomic(uintptr_t) **prev) {
+retry:
+    *prev = &list->head.next;
+    ConcNode *current = CONC_PTR(atomic_load(*prev));
+    while (current) {
+        uintptr_t next = atomic_load(&current->next);
+        if (next & CONC_MARK) {
+            // Deleted but still linked: unlink it or start over
+            uintptr_t expected = (uintptr_t)current;
+            if (!atomic_compare_exchange_strong(*prev, &expected,
+                                                next & ~CONC_MARK))
+                goto retry;
+            conc_retire(list, self, current);
+            current = CONC_PTR(next);
+            continue;
+        }
+        if (current->data >= data) return current;
+        *prev = &current->next;
+        current = CONC_PTR(next);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Inserts the specified data in ascending order.
+ *
+ * @param list A pointer to the concurrent list.
+ * @param self The calling thread's record.
+ * @param data The data to insert into the list.
+ * @return Whether the data was inserted.
+ */
+int conclist_insert(ConcList *list, ConcThread *self, uint16_t data) {
+    conc_enter(list, self);
+    ConcNode *new_node = conc_new_node(list, self);
+    if (!new_node) {
+        conc_exit(self);
+        printf_red("Memory allocation for insertion failed!\n");
+        return 0;
+    }
+    new_node->data = data;
+
+    // Counted before it is linked, so a delete of it can never take the
+    // count below zero
+    atomic_fetch_add_explicit(&list->count, 1, memory_order_relaxed);
+    while (1) {
+        _Atomic(uintptr_t) *prev;
+        ConcNode *current = conc_find(list, self, data, &prev);
+        atomic_store_explicit(&new_node->next, (uintptr_t)current,
+                              memory_order_relaxed);
+        uintptr_t expected = (uintptr_t)current;
+        if (atomic_compare_exchange_strong(prev, &expected,
+                                           (uintptr_t)new_node))
+            break;
+    }
+    conc_exit(self);
+    return 1;
+}
+
+/**
+ * @brief Removes a node with the specified data from the concurrent list.
+ *
+ * @param list A pointer to the concurrent list.
+ * @param self The calling thread's record.
+ * @param data The data to remove from the list.
+ * @return Whether a node was removed.
+ */
+int conclist_delete(ConcList *list, ConcThread *self, uint16_t data) {
+    conc_enter(list, self);
+    while (1) {
+        _Atomic(uintptr_t) *prev;
+        ConcNode *current = conc_find(list, self, data, &prev);
+        if (!current || current->data != data) {
+            conc_exit(self);
+            return 0;
+        }
+
+        // Marking the node is the linearization point of the delete
+        uintptr_t next = atomic_load(&current->next);
+        if (next & CONC_MARK) continue;
+        if (!atomic_compare_exchange_strong(&current->next, &next,
+                                            next | CONC_MARK))
+            continue;
+
+        uintptr_t expected = (uintptr_t)current;
+        if (atomic_compare_exchange_strong(prev, &expected, next))
+            conc_retire(list, self, current);
+        else
+            conc_find(list, self, data, &prev);  // Let find unlink it
+
+        atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+        conc_exit(self);
+        return 1;
+    }
+}
+
+/**
+ * @brief Checks whether the concurrent list holds the specified data, without
+ * taking locks or writing to shared memory.
+ *
+ * @param list A pointer to the concurrent list.
+ * @param self The calling thread's record.
+ * @param data The data to search for.
+ * @return Whether an undeleted node holds the data.
+ */
+int conclist_contains(ConcList *list, ConcThread *self, uint16_t data) {
+    conc_enter(list, self);
+    ConcNode *current = CONC_PTR(atomic_load(&list->head.next));
+    int found = 0;
+    while (current && current->data <= data) {
+        uintptr_t next = atomic_load(&current->next);
+        if (current->data == data && !(next & CONC_MARK)) {
+            found = 1;
+            break;
+        }
+        current = CONC_PTR(next);
+    }
+    conc_exit(self);
+    return found;
+}
+
+/**
+ * @brief Counts the number of nodes in the concurrent list.
+ *
+ * @param list A pointer to the concurrent list.
+ * @return The number of nodes in the list, including any whose insertion is
+ * still in progress.
+ */
+size_t conclist_count(ConcList *list) {
+    return atomic_load(&list->count);
+}
+
+/**
+ * @brief Frees all the nodes in the concurrent list. No thread may be using
+ * the list.
+ *
+ * @param list A pointer to the concurrent list.
+ */
+void conclist_cleanup(ConcList *list) {
+    node_pool_release(&list->pool);
+    pthread_mutex_destroy(&list->pool_lock);
+    atomic_store(&list->head.next, 0);
+    for (int i = 0; i < 3; i++) atomic_store(&list->retired[i], NULL);
+    atomic_store(&list->count, 0);
+    atomic_store(&list->thread_count, 0);
+    if (list->owns_pool) mem_deinit();
+}
+
+// ********* Unrolled linked list *********
+
+/**
+ * @brief Finds the first occurrence of `key` among `count` packed values.
+ *
+ * @return The index of the value, or -1 if it is not present.
+ */
+static int find_u16_scalar(const uint16_t *values, int count, uint16_t key) {
+    for (int i = 0; i < count; i++)
+        if (values[i] == key) return i;
+    return -1;
+}
+
+#ifdef LIST_X86_SIMD
+__attribute__((target("sse2"))) static int find_u16_sse2(
+    const uint16_t *values, int count, uint16_t key) {
+    __m128i needle = _mm_set1_epi16(key);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(values + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, needle));
+        if (mask) return i + __builtin_ctz(mask) / 2;
+    }
+    for (; i < count; i++)
+        if (values[i] == key) return i;
+    return -1;
+}
+
+__attribute__((target("avx2"))) static int find_u16_avx2(
+    const uint16_t *values, int count, uint16_t key) {
+    __m256i needle = _mm256_set1_epi16(key);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(values + i));
+        int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(chunk, needle));
+        if (mask) return i + __builtin_ctz(mask) / 2;
+    }
+    if (i + 8 <= count) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(values + i));
+        int mask = _mm_movemask_epi8(
+            _mm_cmpeq_epi16(chunk, _mm256_castsi256_si128(needle)));
+        if (mask) return i + __builtin_ctz(mask) / 2;
+        i += 8;
+    }
+    for (; i < count; i++)
+        if (values[i] == key) return i;
+    return -1;
+}
+#endif
+
+static int find_u16_resolve(const uint16_t *values, int count, uint16_t key);
+
+// Picked on first use from what the CPU supports.
+static int (*find_u16)(const uint16_t *, int, uint16_t) = find_u16_resolve;
+
+static int find_u16_resolve(const uint16_t *values, int count, uint16_t key) {
+    find_u16 = find_u16_scalar;
+#ifdef LIST_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        find_u16 = find_u16_avx2;
+    else if (__builtin_cpu_supports("sse2"))
+        find_u16 = find_u16_sse2;
+#endif
+    return find_u16(values, count, key);
+}
+
+/**
+ * @brief Initializes the unrolled linked list.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param size The size in bytes to allocate.
+ */
+void ulist_init(UnrolledList *list, size_t size) {
+    mem_init(size + NODE_POOL_SLACK);
+    ulist_attach(list, size);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes the unrolled list in a region of an already initialized
+ * memory manager, like list_attach does for plain lists.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param size The size in bytes to reserve for the list's nodes. The region
+ * takes NODE_POOL_SLACK bytes more.
+ */
+void ulist_attach(UnrolledList *list, size_t size) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->owns_pool = 0;
+    node_pool_init(&list->pool, size, sizeof(UnrolledNode),
+                   offsetof(UnrolledNode, next));
+    if (!list->pool.region)
+        printf_red("Memory allocation for the list failed!\n");
+}
+
+/**
+ * @brief Allocates an empty unrolled node.
+ *
+ * @return A pointer to the new node, or NULL if the allocation fails.
+ */
+static UnrolledNode *ulist_new_node(UnrolledList *list) {
+    UnrolledNode *node = node_pool_alloc(&list->pool);
+    if (!node) return NULL;
+    node->next = NULL;
+    node->count = 0;
+    return node;
+}
+
+/**
+ * @brief Inserts the specified data at the end of the unrolled list.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param data The data to insert into the list.
+ */
+void ulist_insert(UnrolledList *list, uint16_t data) {
+    UnrolledNode *node = list->tail;
+    if (!node || node->count == UNROLLED_CAPACITY) {
+        node = ulist_new_node(list);
+        if (!node) {
+            printf_red("Memory allocation for insertion failed!\n");
+            return;
+        }
+        if (list->tail)
+            list->tail->next = node;
+        else
+            list->head = node;
+        list->tail = node;
+    }
+    node->values[node->count++] = data;
+    list->count++;
+}
+
+/**
+ * @brief Inserts the specified data after the given position, splitting the
+ * node in two if it is full.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param pos The position to insert data after.
+ * @param data The data to insert into the list.
+ */
+void ulist_insert_after(UnrolledList *list, UnrolledPos pos, uint16_t data) {
+    UnrolledNode *node = pos.node;
+    if (!node) {
+        printf_red("Previous node is null!\n");
+        return;
+    }
+    int index = pos.index + 1;
+
+    if (node->count == UNROLLED_CAPACITY) {
+        UnrolledNode *split = ulist_new_node(list);
+        if (!split) {
+            printf_red("Memory allocation for insertion after failed!\n");
+            return;
+        }
+        // Move the upper half of the values to the new node
+        int keep = UNROLLED_CAPACITY / 2;
+        split->count = node->count - keep;
+        memcpy(split->values, node->values + keep,
+               split->count * sizeof(uint16_t));
+        node->count = keep;
+        split->next = node->next;
+        node->next = split;
+        if (list->tail == node) list->tail = split;
+
+        if (index > keep) {
+            node = split;
+            index -= keep;
+        }
+    }
+
+    memmove(node->values + index + 1, node->values + index,
+            (node->count - index) * sizeof(uint16_t));
+    node->values[index] = data;
+    node->count++;
+    list->count++;
+}
+
+/**
+ * @brief Removes the first occurrence of the specified data from the unrolled
+ * list, merging the node with its successor once it is less than half full.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param data The data to remove from the list.
+ */
+void ulist_delete(UnrolledList *list, uint16_t data) {
+    UnrolledNode *previous = NULL;
+    UnrolledNode *node = list->head;
+    int index = -1;
+    while (node) {
+        index = find_u16(node->values, node->count, data);
+        if (index >= 0) break;
+        previous = node;
+        node = node->next;
+    }
+    if (!node) return;
+
+    memmove(node->values + index, node->values + index + 1,
+            (node->count - index - 1) * sizeof(uint16_t));
+    node->count--;
+    list->count--;
+
+    if (node->count == 0) {
+        if (previous)
+            previous->next = node->next;
+        else
+            list->head = node->next;
+        if (list->tail == node) list->tail = previous;
+        node_pool_free(&list->pool, node);
+        return;
+    }
+
+    UnrolledNode *next = node->next;
+    if (node->count >= UNROLLED_CAPACITY / 2 || !next) return;
+
+    if (node->count + next->count <= UNROLLED_CAPACITY) {
+        // Merge the successor into this node
+        memcpy(node->values + node->count, next->values,
+               next->count * sizeof(uint16_t));
+        node->count += next->count;
+        node->next = next->next;
+        if (list->tail == next) list->tail = node;
+        node_pool_free(&list->pool, next);
+    } else {
+        // Borrow from the successor until this node is half full again
+        int moved = UNROLLED_CAPACITY / 2 - node->count;
+        memcpy(node->values + node->count, next->values,
+               moved * sizeof(uint16_t));
+        memmove(next->values, next->values + moved,
+                (next->count - moved) * sizeof(uint16_t));
+        node->count += moved;
+        next->count -= moved;
+    }
+}
+
+/**
+ * @brief Searches for the first occurrence of the specified data, comparing
+ * 8 or 16 packed values per instruction where the CPU allows.
+ *
+ * @param list A pointer to the unrolled list.
+ * @param data The data to search for.
+ * @return The position of the value, or a position with a NULL node if it is
+ * not in the list.
+ */
+UnrolledPos ulist_search(UnrolledList *list, uint16_t data) {
+    for (UnrolledNode *node = list->head; node; node = node->next) {
+        int index = find_u16(node->values, node->count, data);
+        if (index >= 0) return (UnrolledPos){node, index};
+    }
+    return (UnrolledPos){NULL, -1};
+}
+
+/**
+ * @brief Prints all elements of the unrolled list.
+ *
+ * @param list A pointer to the unrolled list.
+ */
+void ulist_display(UnrolledList *list) {
+    printf("[");
+    for (UnrolledNode *node = list->head; node; node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            printf("%d", node->values[i]);
+            if (i + 1 < node->count || node->next) printf(", ");
+        }
+    }
+    printf("]");
+}
+
+/**
+ * @brief Counts the number of values in the unrolled list.
+ *
+ * @param list A pointer to the unrolled list.
+ * @return The number of values in the list.
+ */
+int ulist_count(UnrolledList *list) { return list->count; }
+
+/**
+ * @brief Frees all the nodes in the unrolled list in constant time.
+ *
+ * @param list A pointer to the unrolled list.
+ */
+void ulist_cleanup(UnrolledList *list) {
+    node_pool_release(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    if (list->owns_pool) mem_deinit();
+}
+
+// ********* Compact index-linked list *********
+
+#define COMPACT_INITIAL_CAPACITY 16
+
+/**
+ * @brief Initializes the compact list.
+ *
+ * @param list A pointer to the compact list.
+ * @param size The size in bytes to allocate.
+ */
+void clist_init(CompactList *list, size_t size) {
+    mem_init(size);
+    clist_attach(list);
+    list->owns_pool = 1;
+}
+
+/**
+ * @brief Initializes the compact list on an already initialized memory
+ * manager, like list_attach does for plain lists. The node array grows in the
+ * shared pool, so there is no region to reserve up front.
+ *
+ * @param list A pointer to the compact list.
+ */
+void clist_attach(CompactList *list) {
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->used = 0;
+    list->free = COMPACT_NIL;
+    list->head = COMPACT_NIL;
+    list->tail = COMPACT_NIL;
+    list->count = 0;
+    list->owns_pool = 0;
+}
+
+/**
+ * @brief Takes a node from the compact list's array, growing the array when
+ * it is full.
+ *
+ * @param list A pointer to the compact list.
+ * @return The handle of the node, or COMPACT_NIL if the pool is exhausted.
+ */
+static CompactHandle clist_new_node(CompactList *list) {
+    if (list->free != COMPACT_NIL) {
+        CompactHandle node = list->free;
+        list->free = list->nodes[node].next;
+        return node;
+    }
+
+    if (list->used == list->capacity) {
+        // Double the array, settling for less when the pool is nearly full
+        uint32_t grow =
+            list->capacity ? list->capacity : COMPACT_INITIAL_CAPACITY;
+        CompactNode *nodes = NULL;
+        for (; grow > 0 && !nodes; grow /= 2) {
+            if (list->capacity + grow >= COMPACT_NIL) continue;
+            nodes = mem_resize(list->nodes,
+                               (list->capacity + grow) * sizeof(CompactNode));
+            if (nodes) list->capacity += grow;
+        }
+        if (!nodes) return COMPACT_NIL;
+        list->nodes = nodes;
+    }
+    return list->used++;
+}
+
+/**
+ * @brief Inserts the specified data at the end of the compact list.
+ *
+ * @param list A pointer to the compact list.
+ * @param data The data to insert into the list.
+ * @return The handle of the new node, or COMPACT_NIL if it failed.
+ */
+CompactHandle clist_insert(CompactList *list, uint16_t data) {
+    CompactHandle node = clist_new_node(list);
+    if (node == COMPACT_NIL) {
+        printf_red("Memory allocation for insertion failed!\n");
+        return COMPACT_NIL;
+    }
+    list->nodes[node].data = data;
+    list->nodes[node].next = COMPACT_NIL;
+
+    if (list->tail != COMPACT_NIL)
+        list->nodes[list->tail].next = node;
+    else
+        list->head = node;
+    list->tail = node;
+    list->count++;
+    return node;
+}
+
+/**
+ * @brief Inserts the specified data after the given node.
+ *
+ * @param list A pointer to the compact list.
+ * @param prev_node The handle of the node to insert data after.
+ * @param data The data to insert into the list.
+ * @return The handle of the new node, or COMPACT_NIL if it failed.
+ */
+CompactHandle clist_insert_after(CompactList *list, CompactHandle prev_node,
+                                 uint16_t data) {
+    if (prev_node == COMPACT_NIL) {
+        printf_red("Previous node is null!\n");
+        return COMPACT_NIL;
+    }
+    CompactHandle node = clist_new_node(list);
+    if (node == COMPACT_NIL) {
+        printf_red("Memory allocation for insertion after failed!\n");
+        return COMPACT_NIL;
+    }
+    list->nodes[node].data = data;
+    list->nodes[node].next = list->nodes[prev_node].next;
+    list->nodes[prev_node].next = node;
+
+    if (list->tail == prev_node) list->tail = node;
+    list->count++;
+    return node;
+}
+
+/**
+ * @brief Removes a node with the specified data from the compact list.
+ *
+ * @param list A pointer to the compact list.
+ * @param data The data to remove from the list.
+ */
+void clist_delete(CompactList *list, uint16_t data) {
+    CompactHandle previous = COMPACT_NIL;
+    CompactHandle current = list->head;
+    while (current != COMPACT_NIL && list->nodes[current].data != data) {
+        previous = current;
+        current = list->nodes[current].next;
+    }
+    if (current == COMPACT_NIL) return;
+
+    if (previous != COMPACT_NIL)
+        list->nodes[previous].next = list->nodes[current].next;
+    else
+        list->head = list->nodes[current].next;
+    if (list->tail == current) list->tail = previous;
+
+    list->nodes[current].next = list->free;
+    list->free = current;
+    list->count--;
+}
+
+/**
+ * @brief Searches for a node with the specified data.
+ *
+ * @param list A pointer to the compact list.
+ * @param data The data to search for.
+ * @return The handle of the node, or COMPACT_NIL if it is not in the list.
+ */
+CompactHandle clist_search(CompactList *list, uint16_t data) {
+    CompactHandle current = list->head;
+    while (current != COMPACT_NIL && list->nodes[current].data != data)
+        current = list->nodes[current].next;
+    return current;
+}
+
+/**
+ * @brief Returns the data stored in a node.
+ *
+ * @param list A pointer to the compact list.
+ * @param node The handle of the node.
+ * @return The data of the node.
+ */
+uint16_t clist_data(CompactList *list, CompactHandle node) {
+    return list->nodes[node].data;
+}
+
+/**
+ * @brief Prints all elements of the compact list.
+ *
+ * @param list A pointer to the compact list.
+ */
+void clist_display(CompactList *list) {
+    clist_display_range(list, COMPACT_NIL, COMPACT_NIL);
+}
+
+/**
+ * @brief Prints all elements of the compact list between two nodes
+ * (inclusive).
+ *
+ * @param list A pointer to the compact list.
+ * @param start_node The start node (COMPACT_NIL for start of the list).
+ * @param end_node The end node (COMPACT_NIL for end of the list).
+ */
+void clist_display_range(CompactList *list, CompactHandle start_node,
+                         CompactHandle end_node) {
+    printf("[");
+    if (start_node == COMPACT_NIL) start_node = list->head;
+    if (end_node != COMPACT_NIL) end_node = list->nodes[end_node].next;
+    while (start_node != COMPACT_NIL && start_node != end_node) {
+        printf("%d", list->nodes[start_node].data);
+        start_node = list->nodes[start_node].next;
+        if (start_node != COMPACT_NIL && start_node != end_node) printf(", ");
+    }
+    printf("]");
+}
+
+/**
+ * @brief Counts the number of nodes in the compact list.
+ *
+ * @param list A pointer to the compact list.
+ * @return The number of nodes in the list.
+ */
+int clist_count(CompactList *list) { return list->count; }
+
+/**
+ * @brief Frees the compact list's node array.
+ *
+ * @param list A pointer to the compact list.
+ */
+void clist_cleanup(CompactList *list) {
+    mem_free(list->nodes);
+    list->nodes = NULL;
+    list->capacity = 0;
+    list->used = 0;
+    list->free = COMPACT_NIL;
+    list->head = COMPACT_NIL;
+    list->tail = COMPACT_NIL;
+    list->count = 0;
+    if (list->owns_pool) mem_deinit();
 }
@@ -1,3 +1,6 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,13 +13,281 @@ typedef struct Node {
     struct Node *next;
 } Node;
 
-void list_init(Node **head, size_t size);
-void list_insert(Node **head, uint16_t data);
-void list_insert_after(Node *prev_node, uint16_t data);
-void list_insert_before(Node **head, Node *next_node, uint16_t data);
-void list_delete(Node **head, uint16_t data);
-Node *list_search(Node **head, uint16_t data);
-void list_display(Node **head);
-void list_display_range(Node **head, Node *start_node, Node *end_node);
-int list_count_nodes(Node **head);
-void list_cleanup(Node **head);
+// Optional value index. For each of the 65,536 values it holds the number of
+// nodes with that value and the link pointing at the first of them, or NULL
+// when that link has to be looked up again.
+typedef struct ListIndex {
+    uint32_t count[UINT16_MAX + 1];
+    Node **link[UINT16_MAX + 1];
+} ListIndex;
+
+// Fixed-size node storage carved from the memory manager in one region.
+// Released nodes are threaded through their own link field, so allocating
+// and freeing a node is O(1) with no per-node metadata.
+typedef struct NodePool {
+    void *region;
+    char *bump;  // First never-used byte of the region
+    char *end;
+    void *free;
+    size_t node_size;
+    size_t link_offset;
+} NodePool;
+
+// Bytes a node pool's region takes beyond the size asked for, so the nodes
+// can start pointer-aligned wherever the memory manager placed the region.
+// A pool shared by attached lists needs this much extra room per list.
+#define NODE_POOL_SLACK (sizeof(void *) - 1)
+
+// Skip-list towers kept beside a sorted list. Each index node points at a
+// list node and at the index node for the same list node one level down, so
+// the list nodes themselves keep their layout.
+#define LIST_SKIP_LEVELS 16
+
+typedef struct SkipIndex {
+    Node *node;
+    struct SkipIndex *right;
+    struct SkipIndex *down;
+} SkipIndex;
+
+typedef struct ListSkip {
+    SkipIndex *head[LIST_SKIP_LEVELS];
+    int levels;
+    uint32_t seed;
+    NodePool pool;
+    void *block;  // Memory manager block holding this struct, at an offset
+} ListSkip;
+
+typedef struct List {
+    Node *head;
+    Node *tail;
+    size_t count;
+    ListIndex *index;
+    ListSkip *skip;  // NULL unless the list is sorted
+    NodePool pool;
+    int owns_pool;  // Whether cleanup also deinitializes the memory manager
+} List;
+
+// Where list_compact moved each node: `slot[i]` is the new position of the
+// node that was the i-th slot from `base`, or LIST_REMAP_NONE if that slot
+// held no node.
+#define LIST_REMAP_NONE UINT32_MAX
+
+typedef struct ListRemap {
+    Node *base;
+    size_t slots;
+    uint32_t *slot;
+} ListRemap;
+
+// Batched traversal. Values are handed out LIST_BATCH at a time while a
+// cursor running LIST_PREFETCH_DISTANCE nodes ahead prefetches the nodes
+// still to come.
+#define LIST_BATCH 64
+#define LIST_PREFETCH_DISTANCE 8
+
+typedef void (*ListVisitor)(const uint16_t *values, size_t count, void *ctx);
+
+typedef struct ListIter {
+    Node *node;   // Next node to read
+    Node *ahead;  // Prefetch cursor
+    uint16_t values[LIST_BATCH];
+} ListIter;
+
+// On-disk list format: the magic "LLST", a 16-bit version, a 16-bit
+// encoding and a 64-bit count, all little-endian, then the values either as
+// raw 16-bit words or as zigzag varints of the difference to the previous
+// value.
+typedef enum ListEncoding {
+    LIST_ENCODING_RAW,
+    LIST_ENCODING_DELTA
+} ListEncoding;
+
+// `list_init` and the functions that build a whole list at once create a new
+// memory manager pool, discarding the current one along with every list
+// attached to it. `list_attach` and the `_attached` variants carve the list
+// from the current pool instead. The other list kinds below follow the same
+// rule with their own `_init` and `_attach` functions; `conclist_attach`
+// registers a thread, so the concurrent list uses `conclist_init_attached`.
+void list_init(List *list, size_t size);
+void list_attach(List *list, size_t size);
+void list_insert(List *list, uint16_t data);
+void list_insert_after(List *list, Node *prev_node, uint16_t data);
+void list_insert_before(List *list, Node *next_node, uint16_t data);
+void list_delete(List *list, uint16_t data);
+size_t list_delete_all(List *list, uint16_t data);
+typedef int (*ListPredicate)(uint16_t data, void *ctx);
+size_t list_delete_if(List *list, ListPredicate predicate, void *ctx);
+Node *list_search(List *list, uint16_t data);
+void list_display(List *list);
+void list_display_range(List *list, Node *start_node, Node *end_node);
+void list_display_range_to(List *list, Node *start_node, Node *end_node,
+                           FILE *stream);
+void list_display_range_fd(List *list, Node *start_node, Node *end_node,
+                           int fd);
+int list_count_nodes(List *list);
+void list_cleanup(List *list);
+void list_index_enable(List *list);
+void list_index_disable(List *list);
+void list_init_sorted(List *list, size_t size);
+void list_attach_sorted(List *list, size_t size);
+Node *list_lower_bound(List *list, uint16_t data);
+void list_display_values(List *list, uint16_t low, uint16_t high);
+void list_from_array(List *list, const uint16_t *values, size_t count);
+void list_from_array_attached(List *list, const uint16_t *values,
+                              size_t count);
+size_t list_append_array(List *list, const uint16_t *values, size_t count);
+size_t list_to_array(List *list, uint16_t *values, size_t capacity);
+void list_compact(List *list, ListRemap *remap);
+Node *list_remap(ListRemap *remap, Node *node);
+void list_remap_free(ListRemap *remap);
+void list_iter_init(ListIter *iter, List *list);
+size_t list_iter_next(ListIter *iter);
+void list_visit(List *list, ListVisitor visitor, void *ctx);
+int list_save(List *list, const char *path, ListEncoding encoding);
+int list_load(List *list, const char *path);
+int list_load_attached(List *list, const char *path);
+
+// Doubly linked list: a known node can be inserted before or removed in O(1).
+typedef struct DNode {
+    uint16_t data;
+    struct DNode *prev;
+    struct DNode *next;
+} DNode;
+
+typedef struct DList {
+    DNode *head;
+    DNode *tail;
+    size_t count;
+    NodePool pool;
+    int owns_pool;
+} DList;
+
+void dlist_init(DList *list, size_t size);
+void dlist_attach(DList *list, size_t size);
+void dlist_insert(DList *list, uint16_t data);
+void dlist_insert_after(DList *list, DNode *prev_node, uint16_t data);
+void dlist_insert_before(DList *list, DNode *next_node, uint16_t data);
+void dlist_remove_node(DList *list, DNode *node);
+void dlist_delete(DList *list, uint16_t data);
+DNode *dlist_search(DList *list, uint16_t data);
+void dlist_display(DList *list);
+void dlist_display_range(DList *list, DNode *start_node, DNode *end_node);
+int dlist_count(DList *list);
+void dlist_cleanup(DList *list);
+
+// Concurrent sorted list (Harris-Michael). Readers and writers run in
+// parallel without locks; a node is marked deleted through the low bit of its
+// `next` link before being unlinked. Unlinked nodes are reclaimed through
+// epochs once no thread can still be reading them. Every thread attaches once
+// with `conclist_attach` and passes its ConcThread to each operation.
+//
+// Each ConcThread sits on its own cache line, which makes ConcList 64-byte
+// aligned. Keep one in static or automatic storage, or allocate it with
+// `aligned_alloc(_Alignof(ConcList), sizeof(ConcList))`; plain `malloc` does
+// not guarantee that alignment.
+#define CONC_MAX_THREADS 64
+
+typedef struct ConcNode {
+    uint16_t data;
+    _Atomic(uintptr_t) next;
+    struct ConcNode *free_next;  // Retired or free chain, never read by others
+} ConcNode;
+
+typedef struct ConcThread {
+    _Alignas(64) atomic_int active;
+    atomic_ulong epoch;
+    ConcNode *free;  // Nodes ready for reuse by this thread
+    unsigned retired_count;
+} ConcThread;
+
+typedef struct ConcList {
+    ConcNode head;  // Sentinel, never deleted
+    atomic_ulong epoch;
+    _Atomic(ConcNode *) retired[3];  // Unlinked nodes, by epoch at unlink % 3
+    atomic_int thread_count;
+    atomic_size_t count;
+    pthread_mutex_t pool_lock;
+    NodePool pool;
+    int owns_pool;
+    ConcThread threads[CONC_MAX_THREADS];
+} ConcList;
+
+void conclist_init(ConcList *list, size_t size);
+void conclist_init_attached(ConcList *list, size_t size);
+ConcThread *conclist_attach(ConcList *list);
+int conclist_insert(ConcList *list, ConcThread *self, uint16_t data);
+int conclist_delete(ConcList *list, ConcThread *self, uint16_t data);
+int conclist_contains(ConcList *list, ConcThread *self, uint16_t data);
+size_t conclist_count(ConcList *list);
+void conclist_cleanup(ConcList *list);
+
+// Unrolled list: every node packs a cache line's worth of values.
+#define UNROLLED_NODE_SIZE 64
+#define UNROLLED_CAPACITY                                       \
+    ((UNROLLED_NODE_SIZE - sizeof(void *) - sizeof(uint16_t)) / \
+     sizeof(uint16_t))
+
+typedef struct UnrolledNode {
+    struct UnrolledNode *next;
+    uint16_t count;
+    uint16_t values[UNROLLED_CAPACITY];
+} UnrolledNode;
+
+typedef struct UnrolledList {
+    UnrolledNode *head;
+    UnrolledNode *tail;
+    size_t count;
+    NodePool pool;
+    int owns_pool;
+} UnrolledList;
+
+// Position of a value in an unrolled list; invalidated by any modification.
+typedef struct UnrolledPos {
+    UnrolledNode *node;
+    int index;
+} UnrolledPos;
+
+void ulist_init(UnrolledList *list, size_t size);
+void ulist_attach(UnrolledList *list, size_t size);
+void ulist_insert(UnrolledList *list, uint16_t data);
+void ulist_insert_after(UnrolledList *list, UnrolledPos pos, uint16_t data);
+void ulist_delete(UnrolledList *list, uint16_t data);
+UnrolledPos ulist_search(UnrolledList *list, uint16_t data);
+void ulist_display(UnrolledList *list);
+int ulist_count(UnrolledList *list);
+void ulist_cleanup(UnrolledList *list);
+
+// Compact list: nodes live in one pool-allocated array and link by 32-bit
+// index, so a node takes 8 bytes instead of 16. Handles are array indices and
+// stay valid while the array grows.
+typedef uint32_t CompactHandle;
+#define COMPACT_NIL UINT32_MAX
+
+typedef struct CompactNode {
+    uint16_t data;
+    CompactHandle next;
+} CompactNode;
+
+typedef struct CompactList {
+    CompactNode *nodes;
+    uint32_t capacity;
+    uint32_t used;  // Nodes below this index have been handed out before
+    CompactHandle free;
+    CompactHandle head;
+    CompactHandle tail;
+    size_t count;
+    int owns_pool;
+} CompactList;
+
+void clist_init(CompactList *list, size_t size);
+void clist_attach(CompactList *list);
+CompactHandle clist_insert(CompactList *list, uint16_t data);
+CompactHandle clist_insert_after(CompactList *list, CompactHandle prev_node,
+                                 uint16_t data);
+void clist_delete(CompactList *list, uint16_t data);
+CompactHandle clist_search(CompactList *list, uint16_t data);
+uint16_t clist_data(CompactList *list, CompactHandle node);
+void clist_display(CompactList *list);
+void clist_display_range(CompactList *list, CompactHandle start_node,
+                         CompactHandle end_node);
+int clist_count(CompactList *list);
+void clist_cleanup(CompactList *list);
@@ -1,18 +1,217 @@
+#define _GNU_SOURCE  // For mremap
 #include "memory_manager.h"
 
+#include "common_defs.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 void *memory;
 MemoryBlock *memory_head;
 size_t memory_size;
 
+// Requests of at least `large_threshold` bytes (0 disables) bypass the pool
+// and get a mapping of their own, tracked on the unordered `large_head` list.
+static size_t large_threshold;
+static MemoryBlock *large_head;
+
+// Once `trim_high` bytes (0 disables) have been freed since the last trim,
+// free pages beyond the first `trim_low` free bytes go back to the kernel.
+static size_t trim_high;
+static size_t trim_low;
+static size_t freed_since_trim;
+
+// Live and peak bytes per tag. Only the pool owner allocates and releases
+// blocks, so every counter has a single writer; relaxed atomics let any thread
+// read them. Limits of 0 disable the check.
+static _Atomic size_t tag_live[MEM_TAGS];
+static _Atomic size_t tag_peak[MEM_TAGS];
+static size_t tag_limit[MEM_TAGS];
+
+// Blocks freed by threads other than the pool owner. Producers push with a
+// CAS, the owner takes the whole chain with a single exchange, so the queue
+// is lock-free and never sees ABA.
+typedef struct RemoteFree {
+    void *block;
+    struct RemoteFree *next;
+} RemoteFree;
+
+// Times a non-owner `mem_free` retries allocating its queue entry.
+#define MEM_REMOTE_FREE_RETRIES 64
+
+static pthread_t memory_owner;
+static _Atomic(RemoteFree *) remote_frees;
+
+// Bumped whenever the pool is created, torn down or restored, so
+// thread-local small bins filled from an earlier pool are dropped instead of
+// reused.
+unsigned long mem_generation;
+
+// Identifies the pool created by the latest `mem_init`, so a checkpoint is
+// only restored into the pool it was taken from.
+static unsigned long pool_serial;
+_Thread_local MemSmallCache mem_small_cache;
+
+static void mem_release(void *block);
+
+/**
+ * @brief Adds `size` bytes to a tag's live count.
+ */
+static void mem_charge(unsigned tag, size_t size) {
+    size_t live =
+        atomic_load_explicit(&tag_live[tag], memory_order_relaxed) + size;
+    atomic_store_explicit(&tag_live[tag], live, memory_order_relaxed);
+    if (live > atomic_load_explicit(&tag_peak[tag], memory_order_relaxed))
+        atomic_store_explicit(&tag_peak[tag], live, memory_order_relaxed);
+}
+
+/**
+ * @brief Removes `size` bytes from a tag's live count.
+ */
+static void mem_uncharge(unsigned tag, size_t size) {
+    size_t live = atomic_load_explicit(&tag_live[tag], memory_order_relaxed);
+    atomic_store_explicit(&tag_live[tag], live - size, memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether a tag can take `size` more bytes once `released`
+ * bytes of it are given back.
+ */
+static int mem_tag_fits(unsigned tag, size_t released, size_t size) {
+    size_t live = atomic_load_explicit(&tag_live[tag], memory_order_relaxed);
+    return !tag_limit[tag] || live - released + size <= tag_limit[tag];
+}
+
+/**
+ * @brief Returns blocks queued by `mem_free` on other threads to the pool.
+ * Must only be called by the owning thread.
+ */
+static void mem_reclaim_remote_frees() {
+    if (!atomic_load_explicit(&remote_frees, memory_order_relaxed)) return;
+
+    RemoteFree *pending =
+        atomic_exchange_explicit(&remote_frees, NULL, memory_order_acquire);
+    while (pending) {
+        RemoteFree *next = pending->next;
+        mem_release(pending->block);
+        free(pending);
+        pending = next;
+    }
+}
+
 /**
  * @brief Initializes the memory manager with the specified size.
  *
  * @param size The size of the memory pool in bytes.
  */
 void mem_init(size_t size) {
-    memory = malloc(size);
+    // Mapped rather than malloc'd so free pages can be handed back with madvise
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) memory = NULL;
     memory_head = NULL;
     memory_size = size;
+    large_threshold = 0;
+    large_head = NULL;
+    trim_high = 0;
+    trim_low = 0;
+    freed_since_trim = 0;
+    mem_generation++;
+    pool_serial++;
+    for (int tag = 0; tag < MEM_TAGS; tag++) {
+        atomic_store_explicit(&tag_live[tag], 0, memory_order_relaxed);
+        atomic_store_explicit(&tag_peak[tag], 0, memory_order_relaxed);
+        tag_limit[tag] = 0;
+    }
+    memory_owner = pthread_self();
+    atomic_store_explicit(&remote_frees, NULL, memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the size from which allocations are served by a dedicated
+ * mapping instead of the pool. Reset to 0 (disabled) by `mem_init`.
+ *
+ * @param threshold The smallest size in bytes to map directly, or 0 to serve
+ * every request from the pool.
+ */
+void mem_set_large_threshold(size_t threshold) { large_threshold = threshold; }
+
+/**
+ * @brief Maps a block of memory of its own outside the pool.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @param tag The accounting tag of the block.
+ * @return A pointer to the start of the mapping, or NULL if it fails.
+ */
+static void *mem_alloc_large(size_t size, unsigned tag) {
+    MemoryBlock *new_block = malloc(sizeof(MemoryBlock));
+    if (!new_block) return NULL;
+    new_block->tag = tag;
+
+    void *start = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (start == MAP_FAILED) {
+        free(new_block);
+        return NULL;
+    }
+
+    new_block->start = start;
+    new_block->end = start + size;
+    new_block->next = large_head;
+    large_head = new_block;
+    return start;
+}
+
+/**
+ * @brief Finds the directly mapped block starting at `block`.
+ *
+ * @param block A pointer to the start of the memory block.
+ * @return The block's descriptor, or NULL if `block` is not a large block.
+ */
+static MemoryBlock *mem_find_large(void *block) {
+    // Anything inside the pool cannot be a mapping of its own.
+    if (block >= memory && block < memory + memory_size) return NULL;
+
+    MemoryBlock *current = large_head;
+    while (current && current->start != block) current = current->next;
+    return current;
+}
+
+/**
+ * @brief Places `new_block` at the top of the highest gap that fits `size`
+ * bytes, so transient blocks grow down from the end of the pool.
+ *
+ * @param new_block The descriptor to link into the block list.
+ * @param size The size of the allocated block in bytes.
+ * @return A pointer to the start of the allocated memory, or NULL if no gap
+ * fits.
+ */
+static void *mem_place_top(MemoryBlock *new_block, size_t size) {
+    MemoryBlock **link = &memory_head;
+    MemoryBlock **best = NULL;
+    void *gap_start = memory;
+    while (1) {
+        void *gap_end = *link ? (*link)->start : memory + memory_size;
+        if ((size_t)(gap_end - gap_start) >= size) best = link;
+        if (!*link) break;
+        gap_start = (*link)->end;
+        link = &(*link)->next;
+    }
+
+    if (!best) {
+        free(new_block);
+        return NULL;
+    }
+
+    new_block->end = *best ? (*best)->start : memory + memory_size;
+    new_block->start = new_block->end - size;
+    new_block->next = *best;
+    *best = new_block;
+    return new_block->start;
 }
 
 /**
@@ -22,12 +221,33 @@ void mem_init(size_t size) {
  * @return A pointer to the start of the allocated memory, or NULL if the
  * allocation fails.
  */
-void *mem_alloc(size_t size) {
-    if (!memory || size > memory_size) return NULL;
+void *mem_alloc(size_t size) { return mem_alloc_hinted(size, MEM_HINT_DEFAULT); }
+
+/**
+ * @brief Places a new block according to its expected lifetime.
+ *
+ * Long-lived (and unhinted) blocks are placed first-fit from the start of the
+ * pool, transient blocks from the end, so freeing the transient ones leaves
+ * one large gap instead of holes between long-lived blocks.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @param hint The expected lifetime of the block.
+ * @param tag The accounting tag of the block.
+ * @return A pointer to the start of the allocated memory, or NULL if the
+ * allocation fails.
+ */
+static void *mem_place(size_t size, MemHint hint, unsigned tag) {
+    if (large_threshold && size >= large_threshold)
+        return mem_alloc_large(size, tag);
+
+    if (size > memory_size) return NULL;
     if (size == 0) return memory;
 
     MemoryBlock *new_block = malloc(sizeof(MemoryBlock));
     if (!new_block) return NULL;
+    new_block->tag = tag;
+
+    if (hint == MEM_HINT_TRANSIENT) return mem_place_top(new_block, size);
 
     if (!memory_head) {
         memory_head = new_block;
@@ -64,14 +284,122 @@ void *mem_alloc(size_t size) {
     return NULL;
 }
 
+/**
+ * @brief Allocates and accounts for a block.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @param hint The expected lifetime of the block.
+ * @param tag The accounting tag to charge.
+ * @return A pointer to the start of the allocated memory, or NULL if the
+ * allocation fails or the tag's limit would be exceeded.
+ */
+static void *mem_alloc_in(size_t size, MemHint hint, unsigned tag) {
+    if (!memory || tag >= MEM_TAGS) return NULL;
+
+    mem_reclaim_remote_frees();
+
+    if (!mem_tag_fits(tag, 0, size)) return NULL;
+    void *block = mem_place(size, hint, tag);
+    if (block && size) mem_charge(tag, size);
+    return block;
+}
+
+/**
+ * @brief Allocates a block of memory, placing it according to its expected
+ * lifetime. See `mem_place`.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @param hint The expected lifetime of the block.
+ * @return A pointer to the start of the allocated memory, or NULL if the
+ * allocation fails.
+ */
+void *mem_alloc_hinted(size_t size, MemHint hint) {
+    return mem_alloc_in(size, hint, 0);
+}
+
+/**
+ * @brief Allocates a block of memory charged to an accounting tag.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @param tag The tag to charge, below MEM_TAGS.
+ * @return A pointer to the start of the allocated memory, or NULL if the
+ * allocation fails or would take the tag past its soft limit.
+ */
+void *mem_alloc_tagged(size_t size, unsigned tag) {
+    return mem_alloc_in(size, MEM_HINT_DEFAULT, tag);
+}
+
 /**
  * @brief Frees the specified block of memory.
  *
+ * The pool belongs to the thread that called `mem_init`. Frees issued from any
+ * other thread are queued without touching the block list and reclaimed in
+ * bulk by the owner on its next allocation. Queueing takes a small malloc'd
+ * entry; if the system allocator stays out of memory through
+ * MEM_REMOTE_FREE_RETRIES retries, the failure is reported and the block
+ * stays allocated.
+ *
  * @param block A pointer to the start of the memory block.
  */
 void mem_free(void *block) {
+    if (!block || !memory) return;
+
+    if (!pthread_equal(pthread_self(), memory_owner)) {
+        // Give the system allocator a few chances to recover, then report
+        // the block as leaked rather than hang inside a free
+        RemoteFree *entry = malloc(sizeof(RemoteFree));
+        for (int retry = 0; !entry && retry < MEM_REMOTE_FREE_RETRIES;
+             retry++) {
+            sched_yield();
+            entry = malloc(sizeof(RemoteFree));
+        }
+        if (!entry) {
+            printf_red("Queueing a free from another thread failed, the "
+                       "block stays allocated!\n");
+            return;
+        }
+        entry->block = block;
+        entry->next = atomic_load_explicit(&remote_frees, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(
+            &remote_frees, &entry->next, entry, memory_order_release,
+            memory_order_relaxed))
+            ;
+        return;
+    }
+
+    mem_release(block);
+
+    if (trim_high && freed_since_trim >= trim_high) mem_trim(trim_low);
+}
+
+/**
+ * @brief Unlinks the block starting at `block` from the block list.
+ *
+ * @param block A pointer to the start of the memory block.
+ */
+static void mem_release(void *block) {
     if (!block) return;
 
+    if (large_head && !(block >= memory && block < memory + memory_size)) {
+        MemoryBlock *previous = NULL;
+        MemoryBlock *current = large_head;
+        while (current && current->start != block) {
+            previous = current;
+            current = current->next;
+        }
+        if (!current) return;
+
+        if (previous)
+            previous->next = current->next;
+        else
+            large_head = current->next;
+
+        mem_uncharge(current->tag, current->end - current->start);
+        munmap(current->start, current->end - current->start);
+        free(current);
+        return;
+    }
+
     // Get memory block to free
     MemoryBlock *previous = NULL;
     MemoryBlock *current = memory_head;
@@ -88,52 +416,301 @@ void mem_free(void *block) {
     else
         memory_head = current->next;
 
+    freed_since_trim += current->end - current->start;
+    mem_uncharge(current->tag, current->end - current->start);
     free(current);
 }
 
 /**
- * @brief Changes the size of the memory block, possibly moving it.
+ * @brief Changes the size of a block, possibly moving it, and charges it to
+ * `tag` or, if `keep_tag` is set, to the tag it already has.
  *
  * @param block A pointer to the start of the memory block.
  * @param size The new size of the memory block.
+ * @param tag The tag to charge.
+ * @param keep_tag Whether to ignore `tag` and keep the block's own.
  * @return A pointer to the start of the resized memory block, or NULL if the
  * resize fails.
  */
-void *mem_resize(void *block, size_t size) {
+static void *mem_resize_as(void *block, size_t size, unsigned tag,
+                           int keep_tag) {
     if (size == 0) {
         if (block) mem_free(block);
         return NULL;
     }
 
-    if (!block) return mem_alloc(size);
+    if (!block) return mem_alloc_in(size, MEM_HINT_DEFAULT, tag);
+    if (tag >= MEM_TAGS) return NULL;
+
+    // Large blocks grow and shrink in place or by remapping, never by copying
+    MemoryBlock *large = mem_find_large(block);
+    if (large) {
+        size_t large_size = large->end - large->start;
+        if (keep_tag) tag = large->tag;
+        if (!mem_tag_fits(tag, large->tag == tag ? large_size : 0, size))
+            return NULL;
+        void *new_block =
+            mremap(large->start, large_size, size, MREMAP_MAYMOVE);
+        if (new_block == MAP_FAILED) return NULL;
+        mem_uncharge(large->tag, large_size);
+        mem_charge(tag, size);
+        large->tag = tag;
+        large->start = new_block;
+        large->end = new_block + size;
+        return new_block;
+    }
 
     // Get memory block to free
+    MemoryBlock *previous = NULL;
     MemoryBlock *current = memory_head;
-    while (current && current->start != block) current = current->next;
+    while (current && current->start != block) {
+        previous = current;
+        current = current->next;
+    }
     if (!current) return NULL;
 
     size_t current_size = current->end - current->start;
+    unsigned current_tag = current->tag;
+    if (keep_tag) tag = current_tag;
+    if (!mem_tag_fits(tag, current_tag == tag ? current_size : 0, size))
+        return NULL;
 
-    // Free and try to allocate with new size
-    mem_free(block);
-    void *new_block = mem_alloc(size);
+    // Unlink the block so its space can be reused, but keep its pages and
+    // record until the data has moved; trimming now would zero them
+    if (previous)
+        previous->next = current->next;
+    else
+        memory_head = current->next;
+    mem_uncharge(current_tag, current_size);
+
+    void *new_block = mem_alloc_in(size, MEM_HINT_DEFAULT, tag);
     if (!new_block) {
-        mem_alloc(current_size);
+        // Put the block back where it was; the list may have changed while
+        // remote frees were reclaimed, so search for its place again
+        MemoryBlock **link = &memory_head;
+        while (*link && (*link)->start < current->start) link = &(*link)->next;
+        current->next = *link;
+        *link = current;
+        mem_charge(current_tag, current_size);
         return NULL;
     }
 
-    // If resize succeeded, move the memory
+    // If resize succeeded, move the memory; the ranges may overlap
     size_t new_size = (size <= current_size) ? size : current_size;
-    if (new_block != block) memcpy(new_block, block, new_size);
+    if (new_block != block) memmove(new_block, block, new_size);
+    free(current);
+
+    freed_since_trim += current_size;
+    if (trim_high && freed_since_trim >= trim_high) mem_trim(trim_low);
     return new_block;
 }
 
+/**
+ * @brief Changes the size of the memory block, possibly moving it. The block
+ * stays charged to its tag.
+ *
+ * @param block A pointer to the start of the memory block.
+ * @param size The new size of the memory block.
+ * @return A pointer to the start of the resized memory block, or NULL if the
+ * resize fails.
+ */
+void *mem_resize(void *block, size_t size) {
+    return mem_resize_as(block, size, 0, 1);
+}
+
+/**
+ * @brief Changes the size of the memory block, possibly moving it, and
+ * charges it to `tag` from now on.
+ *
+ * @param block A pointer to the start of the memory block.
+ * @param size The new size of the memory block.
+ * @param tag The tag to charge, below MEM_TAGS.
+ * @return A pointer to the start of the resized memory block, or NULL if the
+ * resize fails or would take the tag past its soft limit.
+ */
+void *mem_resize_tagged(void *block, size_t size, unsigned tag) {
+    return mem_resize_as(block, size, tag, 0);
+}
+
+/**
+ * @brief Sets a soft limit on the bytes a tag may have allocated. Reset to 0
+ * (no limit) by `mem_init`.
+ *
+ * @param tag The tag, below MEM_TAGS.
+ * @param limit The most bytes the tag may hold, or 0 for no limit.
+ */
+void mem_set_tag_limit(unsigned tag, size_t limit) {
+    if (tag < MEM_TAGS) tag_limit[tag] = limit;
+}
+
+/**
+ * @brief Reads a tag's accounting counters. Safe to call from any thread.
+ *
+ * @param tag The tag, below MEM_TAGS.
+ * @return The tag's live and peak bytes and its limit, all 0 for an invalid
+ * tag.
+ */
+MemTagStats mem_tag_stats(unsigned tag) {
+    MemTagStats stats = {0, 0, 0};
+    if (tag >= MEM_TAGS) return stats;
+    stats.live = atomic_load_explicit(&tag_live[tag], memory_order_relaxed);
+    stats.peak = atomic_load_explicit(&tag_peak[tag], memory_order_relaxed);
+    stats.limit = tag_limit[tag];
+    return stats;
+}
+
+/**
+ * @brief Drops the calling thread's small bins if they were filled from an
+ * earlier pool.
+ */
+static void mem_small_validate() {
+    if (mem_small_cache.generation == mem_generation) return;
+    memset(&mem_small_cache, 0, sizeof(mem_small_cache));
+    mem_small_cache.generation = mem_generation;
+}
+
+/**
+ * @brief Serves a `mem_alloc_small` request whose bin is empty.
+ *
+ * @param size The size of the allocated block in bytes.
+ * @return A pointer to a block of the size class of `size`, or NULL if the
+ * allocation fails.
+ */
+void *mem_alloc_small_slow(size_t size) {
+    mem_small_validate();
+    return mem_alloc((mem_small_class(size) + 1) * 16);
+}
+
+/**
+ * @brief Frees a `mem_free_small` block whose bin is full or stale.
+ *
+ * @param block A pointer to the start of a block from `mem_alloc_small`.
+ * @param size The size the block was requested with.
+ */
+void mem_free_small_slow(void *block, size_t size) {
+    mem_small_validate();
+    MemSmallBin *bin = &mem_small_cache.bins[mem_small_class(size)];
+    if (bin->count < MEM_SMALL_BIN_LIMIT) {
+        *(void **)block = bin->free;
+        bin->free = block;
+        bin->count++;
+        return;
+    }
+    mem_free(block);
+}
+
+/**
+ * @brief Returns every block cached in the calling thread's small bins to the
+ * pool.
+ */
+void mem_small_flush() {
+    mem_small_validate();
+    for (int i = 0; i < MEM_SMALL_CLASSES; i++) {
+        MemSmallBin *bin = &mem_small_cache.bins[i];
+        while (bin->free) {
+            void *block = bin->free;
+            bin->free = *(void **)block;
+            mem_free(block);
+        }
+        bin->count = 0;
+    }
+}
+
+/**
+ * @brief Returns the resident bytes in the page-aligned range [start, end).
+ */
+static size_t mem_resident_bytes(void *start, void *end, size_t page) {
+    unsigned char pages[256];
+    size_t resident = 0;
+    while (start < end) {
+        size_t length = end - start;
+        if (length > sizeof(pages) * page) length = sizeof(pages) * page;
+        if (mincore(start, length, pages) != 0) return end - start;
+        for (size_t i = 0; i < length / page; i++)
+            if (pages[i] & 1) resident += page;
+        start += length;
+    }
+    return resident;
+}
+
+/**
+ * @brief Returns free pages of the pool to the kernel.
+ *
+ * The lowest `keep_bytes` of free memory, which first-fit hands out next,
+ * stay resident. Every whole page of the remaining free space is released
+ * with `madvise` and reads back as zeroes when reused.
+ *
+ * @param keep_bytes The number of free bytes to keep resident.
+ * @return The number of resident bytes released.
+ */
+size_t mem_trim(size_t keep_bytes) {
+    if (!memory) return 0;
+
+    mem_reclaim_remote_frees();
+
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t released = 0;
+    void *gap_start = memory;
+    MemoryBlock *current = memory_head;
+    while (1) {
+        void *gap_end = current ? current->start : memory + memory_size;
+        size_t gap_size = gap_end - gap_start;
+
+        size_t keep = keep_bytes < gap_size ? keep_bytes : gap_size;
+        keep_bytes -= keep;
+        gap_start += keep;
+
+        // Only pages lying entirely inside the gap can be released
+        void *first = (void *)(((uintptr_t)gap_start + page - 1) & ~(page - 1));
+        void *last = (void *)((uintptr_t)gap_end & ~(page - 1));
+        if (first < last) {
+            released += mem_resident_bytes(first, last, page);
+            madvise(first, last - first, MADV_DONTNEED);
+        }
+
+        if (!current) break;
+        gap_start = current->end;
+        current = current->next;
+    }
+
+    freed_since_trim = 0;
+    return released;
+}
+
+/**
+ * @brief Trims the pool automatically once enough memory has been freed.
+ *
+ * @param high The number of bytes freed since the last trim that triggers a
+ * trim, or 0 to disable automatic trimming.
+ * @param low The number of free bytes to keep resident when trimming.
+ */
+void mem_set_watermarks(size_t high, size_t low) {
+    trim_high = high;
+    trim_low = low;
+}
+
 /**
  * @brief Deinitializes the memory manager previously initialized with
  * `mem_init`.
  */
 void mem_deinit() {
-    free(memory);
+    // Queued remote frees refer to the pool being torn down; drop them.
+    RemoteFree *pending = atomic_exchange(&remote_frees, NULL);
+    while (pending) {
+        RemoteFree *next = pending->next;
+        free(pending);
+        pending = next;
+    }
+
+    while (large_head) {
+        MemoryBlock *temp = large_head;
+        large_head = large_head->next;
+        munmap(temp->start, temp->end - temp->start);
+        free(temp);
+    }
+
+    if (memory) munmap(memory, memory_size);
+    memory = NULL;
 
     while (memory_head) {
         MemoryBlock *temp = memory_head;
@@ -142,4 +719,151 @@ void mem_deinit() {
     }
 
     memory_size = 0;
+    mem_generation++;
 }
+
+struct MemCheckpoint {
+    unsigned long pool;
+    size_t freed_since_trim;
+    size_t blocks;
+    size_t *offsets;  // Start, end (from the pool's start) and tag per block
+    char *data;       // Contents of the blocks, back to back
+};
+
+/**
+ * @brief Captures the pool's block list and the contents of every live block,
+ * so `mem_restore` can return to this state with one copy per block. Free
+ * space is not saved.
+ *
+ * Restoring drops every thread's small bins, so blocks cached in them when
+ * the checkpoint is taken would stay allocated for good. The caller's bins are
+ * flushed here; other threads must call `mem_small_flush` beforehand.
+ *
+ * @return The checkpoint, or NULL if the pool is not initialized, the caller
+ * is not the pool owner, large blocks are live or memory runs out.
+ */
+MemCheckpoint *mem_checkpoint() {
+    if (!memory || !pthread_equal(pthread_self(), memory_owner)) return NULL;
+
+    mem_small_flush();
+    mem_reclaim_remote_frees();
+    if (large_head) return NULL;
+
+    size_t blocks = 0, bytes = 0;
+    for (MemoryBlock *current = memory_head; current; current = current->next) {
+        blocks++;
+        bytes += current->end - current->start;
+    }
+
+    // Descriptor, offsets and contents share one allocation
+    MemCheckpoint *checkpoint =
+        malloc(sizeof(MemCheckpoint) + blocks * 3 * sizeof(size_t) + bytes);
+    if (!checkpoint) return NULL;
+    checkpoint->pool = pool_serial;
+    checkpoint->freed_since_trim = freed_since_trim;
+    checkpoint->blocks = blocks;
+    checkpoint->offsets = (size_t *)(checkpoint + 1);
+    checkpoint->data = (char *)(checkpoint->offsets + blocks * 3);
+
+    size_t *offset = checkpoint->offsets;
+    char *data = checkpoint->data;
+    for (MemoryBlock *current = memory_head; current; current = current->next) {
+        size_t size = current->end - current->start;
+        *offset++ = current->start - memory;
+        *offset++ = current->end - memory;
+        *offset++ = current->tag;
+        memcpy(data, current->start, size);
+        data += size;
+    }
+    return checkpoint;
+}
+
+/**
+ * @brief Returns the pool to the state captured by `mem_checkpoint`. Blocks
+ * allocated since are dropped, large blocks are unmapped and queued remote
+ * frees are discarded. Pointers into blocks that were live at the checkpoint
+ * stay valid.
+ *
+ * @param checkpoint A checkpoint taken from the current pool.
+ * @return Whether the pool was restored.
+ */
+int mem_restore(MemCheckpoint *checkpoint) {
+    if (!memory || !checkpoint || checkpoint->pool != pool_serial ||
+        !pthread_equal(pthread_self(), memory_owner))
+        return 0;
+
+    // Reuse the current descriptors, allocating any missing ones up front so
+    // running out of memory leaves the pool untouched
+    size_t current_blocks = 0;
+    for (MemoryBlock *current = memory_head; current; current = current->next)
+        current_blocks++;
+    MemoryBlock *spare = NULL;
+    for (size_t i = current_blocks; i < checkpoint->blocks; i++) {
+        MemoryBlock *block = malloc(sizeof(MemoryBlock));
+        if (!block) {
+            while (spare) {
+                MemoryBlock *next = spare->next;
+                free(spare);
+                spare = next;
+            }
+            return 0;
+        }
+        block->next = spare;
+        spare = block;
+    }
+
+    // Queued remote frees and large blocks belong to the state being dropped
+    RemoteFree *pending = atomic_exchange(&remote_frees, NULL);
+    while (pending) {
+        RemoteFree *next = pending->next;
+        free(pending);
+        pending = next;
+    }
+    while (large_head) {
+        MemoryBlock *temp = large_head;
+        large_head = large_head->next;
+        munmap(temp->start, temp->end - temp->start);
+        free(temp);
+    }
+
+    // Live bytes are recounted from the restored blocks; peaks are kept
+    for (int tag = 0; tag < MEM_TAGS; tag++)
+        atomic_store_explicit(&tag_live[tag], 0, memory_order_relaxed);
+
+    MemoryBlock **link = &memory_head;
+    size_t *offset = checkpoint->offsets;
+    char *data = checkpoint->data;
+    for (size_t i = 0; i < checkpoint->blocks; i++) {
+        if (!*link) {
+            *link = spare;
+            spare = spare->next;
+            (*link)->next = NULL;
+        }
+        MemoryBlock *block = *link;
+        block->start = memory + *offset++;
+        block->end = memory + *offset++;
+        block->tag = *offset++;
+        mem_charge(block->tag, block->end - block->start);
+        memcpy(block->start, data, block->end - block->start);
+        data += block->end - block->start;
+        link = &block->next;
+    }
+    MemoryBlock *rest = *link;
+    *link = NULL;
+    while (rest) {
+        MemoryBlock *next = rest->next;
+        free(rest);
+        rest = next;
+    }
+
+    freed_since_trim = checkpoint->freed_since_trim;
+    mem_generation++;
+    return 1;
+}
+
+/**
+ * @brief Frees a checkpoint.
+ *
+ * @param checkpoint The checkpoint, or NULL.
+ */
+void mem_checkpoint_free(MemCheckpoint *checkpoint) { free(checkpoint); }
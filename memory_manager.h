@@ -8,12 +8,116 @@ typedef struct MemoryBlock {
     void *start;
     void *end;
     struct MemoryBlock *next;
+    unsigned tag;  // Accounting tag the block is charged to
 } MemoryBlock;
 
+// Expected lifetime of a block, used by `mem_alloc_hinted` for placement.
+typedef enum MemHint {
+    MEM_HINT_DEFAULT,
+    MEM_HINT_LONG_LIVED,
+    MEM_HINT_TRANSIENT,
+} MemHint;
+
 void mem_init(size_t size);
 void *mem_alloc(size_t size);
+void *mem_alloc_hinted(size_t size, MemHint hint);
 void mem_free(void *block);
 void *mem_resize(void *block, size_t size);
 void mem_deinit();
+void mem_set_large_threshold(size_t threshold);
+size_t mem_trim(size_t keep_bytes);
+void mem_set_watermarks(size_t high, size_t low);
+
+// Per-tag accounting. Every block is charged to a tag below MEM_TAGS; blocks
+// from the untagged functions are charged to tag 0. A tag with a soft limit
+// refuses allocations that would take its live bytes past the limit.
+#define MEM_TAGS 16
+
+typedef struct MemTagStats {
+    size_t live;   // Bytes currently allocated
+    size_t peak;   // Highest `live` since `mem_init`
+    size_t limit;  // Soft limit, 0 for none
+} MemTagStats;
+
+void *mem_alloc_tagged(size_t size, unsigned tag);
+void *mem_resize_tagged(void *block, size_t size, unsigned tag);
+void mem_set_tag_limit(unsigned tag, size_t limit);
+MemTagStats mem_tag_stats(unsigned tag);
+
+// Snapshot of the pool's live blocks, their contents and the block list.
+// Threads other than the owner must flush their small bins before one is
+// taken, as restoring drops them.
+typedef struct MemCheckpoint MemCheckpoint;
+
+MemCheckpoint *mem_checkpoint();
+int mem_restore(MemCheckpoint *checkpoint);
+void mem_checkpoint_free(MemCheckpoint *checkpoint);
+
+// Small-object fast path. Blocks of up to MEM_SMALL_MAX bytes freed with
+// `mem_free_small` are kept in thread-local bins, one per 16-byte size class,
+// and handed out again by `mem_alloc_small` without calling into the library.
+// Only bin misses and full bins take the out-of-line path, so the owner rule
+// of `mem_alloc` applies to those.
+//
+// `mem_free_small` trusts `size` to name the block's class: it must be given
+// a block from `mem_alloc_small` and a size in the same 16-byte class as the
+// one it was requested with. Any other block, such as one from `mem_alloc`,
+// goes to `mem_free`; cached under a class it is smaller than, it would be
+// overrun by the next `mem_alloc_small` of that class.
+#define MEM_SMALL_MAX 128
+#define MEM_SMALL_CLASSES (MEM_SMALL_MAX / 16)
+#define MEM_SMALL_BIN_LIMIT 64
+
+typedef struct MemSmallBin {
+    void *free;  // Cached blocks, threaded through their first word
+    unsigned count;
+} MemSmallBin;
+
+typedef struct MemSmallCache {
+    unsigned long generation;  // Pool the bins were filled from
+    MemSmallBin bins[MEM_SMALL_CLASSES];
+} MemSmallCache;
+
+extern _Thread_local MemSmallCache mem_small_cache;
+extern unsigned long mem_generation;
+
+void *mem_alloc_small_slow(size_t size);
+void mem_free_small_slow(void *block, size_t size);
+void mem_small_flush();
+
+static inline size_t mem_small_class(size_t size) {
+    return size ? (size - 1) / 16 : 0;
+}
+
+static inline void *mem_alloc_small(size_t size) {
+    if (size > MEM_SMALL_MAX) return mem_alloc(size);
+
+    MemSmallBin *bin = &mem_small_cache.bins[mem_small_class(size)];
+    void *block = bin->free;
+    if (block && mem_small_cache.generation == mem_generation) {
+        bin->free = *(void **)block;
+        bin->count--;
+        return block;
+    }
+    return mem_alloc_small_slow(size);
+}
+
+static inline void mem_free_small(void *block, size_t size) {
+    if (!block) return;
+    if (size > MEM_SMALL_MAX) {
+        mem_free(block);
+        return;
+    }
+
+    MemSmallBin *bin = &mem_small_cache.bins[mem_small_class(size)];
+    if (bin->count < MEM_SMALL_BIN_LIMIT &&
+        mem_small_cache.generation == mem_generation) {
+        *(void **)block = bin->free;
+        bin->free = block;
+        bin->count++;
+        return;
+    }
+    mem_free_small_slow(block, size);
+}
 
 #endif
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "common_defs.h"
 #include "gitdata.h"
@@ -10,7 +12,7 @@
 
 // Function to capture stdout output.
 void capture_stdout(char *buffer, size_t size,
-                    void (*func)(Node **, Node *, Node *), Node **head,
+                    void (*func)(List *, Node *, Node *), List *list,
                     Node *start_node, Node *end_node) {
     // Save the original stdout
     FILE *original_stdout = stdout;
@@ -26,7 +28,7 @@ void capture_stdout(char *buffer, size_t size,
     stdout = fp;
 
     // Call the function whose output we want to capture
-    func(head, start_node, end_node);
+    func(list, start_node, end_node);
 
     // Flush the output to the temporary file
     fflush(fp);
@@ -49,93 +51,93 @@ void capture_stdout(char *buffer, size_t size,
 
 void test_list_init() {
     printf_yellow("  Testing list_init ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node));
-    my_assert(head == NULL);
-    list_cleanup(&head);
+    List list;
+    list_init(&list, sizeof(Node));
+    my_assert(list.head == NULL);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_insert() {
     printf_yellow("  Testing list_insert ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 2);
-    list_insert(&head, 10);
-    list_insert(&head, 20);
-    my_assert(head->data == 10);
-    my_assert(head->next->data == 20);
-    list_cleanup(&head);
+    List list;
+    list_init(&list, sizeof(Node) * 2);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    my_assert(list.head->data == 10);
+    my_assert(list.head->next->data == 20);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_insert_after() {
     printf_yellow("  Testing list_insert_after ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 3);
-    list_insert(&head, 10);
-    Node *node = head;
-    list_insert_after(node, 20);
+    List list;
+    list_init(&list, sizeof(Node) * 3);
+    list_insert(&list, 10);
+    Node *node = list.head;
+    list_insert_after(&list, node, 20);
     my_assert(node->next->data == 20);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_insert_before() {
     printf_yellow("  Testing list_insert_before ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 3);
-    list_insert(&head, 10);
-    list_insert(&head, 30);
-    Node *node = head->next;  // Node with data 30
-    list_insert_before(&head, node, 20);
-    my_assert(head->next->data == 20);
-
-    list_cleanup(&head);
+    List list;
+    list_init(&list, sizeof(Node) * 3);
+    list_insert(&list, 10);
+    list_insert(&list, 30);
+    Node *node = list.head->next;  // Node with data 30
+    list_insert_before(&list, node, 20);
+    my_assert(list.head->next->data == 20);
+
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_delete() {
     printf_yellow("  Testing list_delete ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 2);
-    list_insert(&head, 10);
-    list_insert(&head, 20);
-    list_delete(&head, 10);
-    my_assert(head->data == 20);
-    list_delete(&head, 20);
-    my_assert(head == NULL);
-
-    list_cleanup(&head);
+    List list;
+    list_init(&list, sizeof(Node) * 2);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    list_delete(&list, 10);
+    my_assert(list.head->data == 20);
+    list_delete(&list, 20);
+    my_assert(list.head == NULL);
+
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_search() {
     printf_yellow("  Testing list_search ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 2);
-    list_insert(&head, 10);
-    list_insert(&head, 20);
-    Node *found = list_search(&head, 10);
+    List list;
+    list_init(&list, sizeof(Node) * 2);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    Node *found = list_search(&list, 10);
     my_assert(found->data == 10);
 
-    Node *not_found = list_search(&head, 30);
+    Node *not_found = list_search(&list, 30);
     my_assert(not_found == NULL);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_display() {
     printf_yellow("  Testing list_display ... \n");
-    Node *head = NULL;
+    List list;
 
     int Nnodes = 5 + rand() % 5;
 #ifdef DEBUG
     printf_yellow("   Testing %d nodes.\n", Nnodes);
 #endif
 
-    list_init(&head, sizeof(Node) * Nnodes);
+    list_init(&list, sizeof(Node) * Nnodes);
 
     int randomLow = rand() % Nnodes;
 
@@ -170,13 +172,13 @@ void test_list_display() {
     }
     for (int k = 0; k < Nnodes; k++) {
         values[k] = 10 + rand() % 90;
-        list_insert(&head, values[k]);
+        list_insert(&list, values[k]);
         if (k == randomLow && !Low) {
-            Low = list_search(&head, values[k]);
+            Low = list_search(&list, values[k]);
             sprintf(LowValue, "%d", values[k]);
         }
         if (k == randomHigh && !High) {
-            High = list_search(&head, values[k]);
+            High = list_search(&list, values[k]);
             sprintf(HighValue, "%d", values[k]);
         }
         sprintf(stringFull + strlen(stringFull), "%d", values[k]);
@@ -270,65 +272,61 @@ void test_list_display() {
     char buffer[1024] = {0};  // Buffer to capture the output
 
     // Test case 1: Displaying full list
-    capture_stdout(buffer, sizeof(buffer),
-                   (void (*)(Node **, Node *, Node *))list_display_range, &head,
-                   NULL, NULL);
+    capture_stdout(buffer, sizeof(buffer), list_display_range, &list, NULL,
+                   NULL);
     my_assert(strcmp(buffer, stringFull) == 0);
     printf("\tFull list: %s\n", buffer);
 
     // Test case 2: Displaying list from second node to end
     memset(buffer, 0, sizeof(buffer));  // Clear buffer
-    capture_stdout(buffer, sizeof(buffer),
-                   (void (*)(Node **, Node *, Node *))list_display_range, &head,
-                   head->next, NULL);
+    capture_stdout(buffer, sizeof(buffer), list_display_range, &list,
+                   list.head->next, NULL);
     my_assert(strcmp(buffer, string2Last) == 0);
     printf("\tFrom second node to end: %s\n", buffer);
 
     // Test case 3: Displaying list from first node to third node
     memset(buffer, 0, sizeof(buffer));  // Clear buffer
-    capture_stdout(buffer, sizeof(buffer),
-                   (void (*)(Node **, Node *, Node *))list_display_range, &head,
-                   head, head->next->next);
+    capture_stdout(buffer, sizeof(buffer), list_display_range, &list,
+                   list.head, list.head->next->next);
     my_assert(strcmp(buffer, string1third) == 0);
     printf("\tFrom first node to third node: %s\n", buffer);
 
     // Test case 4: Displaying random nodes
     memset(buffer, 0, sizeof(buffer));  // Clear buffer
-    capture_stdout(buffer, sizeof(buffer),
-                   (void (*)(Node **, Node *, Node *))list_display_range, &head,
-                   Low, High);
+    capture_stdout(buffer, sizeof(buffer), list_display_range, &list, Low,
+                   High);
     my_assert(strcmp(buffer, stringRandom) == 0);
     printf("\tK random node(s): %s\n", buffer);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("  ... [PASS].\n");
 }
 
 void test_list_count_nodes() {
     printf_yellow("  Testing list_count_nodes ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 3);
-    list_insert(&head, 10);
-    list_insert(&head, 20);
-    list_insert(&head, 30);
+    List list;
+    list_init(&list, sizeof(Node) * 3);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    list_insert(&list, 30);
 
-    int count = list_count_nodes(&head);
+    int count = list_count_nodes(&list);
     my_assert(count == 3);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_cleanup() {
     printf_yellow("  Testing list_cleanup ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 3);
-    list_insert(&head, 10);
-    list_insert(&head, 20);
-    list_insert(&head, 30);
-
-    list_cleanup(&head);
-    my_assert(head == NULL);
+    List list;
+    list_init(&list, sizeof(Node) * 3);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    list_insert(&list, 30);
+
+    list_cleanup(&list);
+    my_assert(list.head == NULL);
     printf_green("[PASS].\n");
 }
 
@@ -336,34 +334,34 @@ void test_list_cleanup() {
 
 void test_list_insert_loop(int count) {
     printf_yellow("  Testing list_insert loop ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * count);
+    List list;
+    list_init(&list, sizeof(Node) * count);
     for (int i = 0; i < count; i++) {
-        list_insert(&head, i);
+        list_insert(&list, i);
     }
 
-    Node *current = head;
+    Node *current = list.head;
     for (int i = 0; i < count; i++) {
         my_assert(current->data == i);
         current = current->next;
     }
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_insert_after_loop(int count) {
     printf_yellow("  Testing list_insert_after loop ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * (count + 1));
-    list_insert(&head, 12345);
+    List list;
+    list_init(&list, sizeof(Node) * (count + 1));
+    list_insert(&list, 12345);
 
-    Node *node = list_search(&head, 12345);
+    Node *node = list_search(&list, 12345);
     for (int i = 0; i < count; i++) {
-        list_insert_after(node, i);
+        list_insert_after(&list, node, i);
     }
 
-    Node *current = head;
+    Node *current = list.head;
     my_assert(current->data == 12345);
     current = current->next;
 
@@ -372,75 +370,953 @@ void test_list_insert_after_loop(int count) {
         current = current->next;
     }
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_delete_loop(int count) {
     printf_yellow("  Testing list_delete loop ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * count);
+    List list;
+    list_init(&list, sizeof(Node) * count);
     for (int i = 0; i < count; i++) {
-        list_insert(&head, i);
+        list_insert(&list, i);
     }
 
     for (int i = 0; i < count; i++) {
-        list_delete(&head, i);
+        list_delete(&list, i);
     }
 
-    my_assert(head == NULL);
+    my_assert(list.head == NULL);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_search_loop(int count) {
     printf_yellow("  Testing list_search loop ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * count);
+    List list;
+    list_init(&list, sizeof(Node) * count);
     for (int i = 0; i < count; i++) {
-        list_insert(&head, i);
+        list_insert(&list, i);
     }
 
     for (int i = 0; i < count; i++) {
-        Node *found = list_search(&head, i);
+        Node *found = list_search(&list, i);
         my_assert(found->data == i);
     }
 
-    list_cleanup(&head);
+    list_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
 void test_list_edge_cases() {
     printf_yellow("  Testing list edge cases ---> ");
-    Node *head = NULL;
-    list_init(&head, sizeof(Node) * 3);
+    List list;
+    list_init(&list, sizeof(Node) * 3);
 
     // Insert at head
-    list_insert(&head, 10);
-    my_assert(head->data == 10);
+    list_insert(&list, 10);
+    my_assert(list.head->data == 10);
 
     // Insert after
-    Node *node = list_search(&head, 10);
-    list_insert_after(node, 20);
+    Node *node = list_search(&list, 10);
+    list_insert_after(&list, node, 20);
     my_assert(node->next->data == 20);
 
     // Insert before
-    list_insert_before(&head, node, 15);
+    list_insert_before(&list, node, 15);
 
-    my_assert(head->data == 15);
-    my_assert(head->next->data == 10);
-    my_assert(head->next->next->data == 20);
+    my_assert(list.head->data == 15);
+    my_assert(list.head->next->data == 10);
+    my_assert(list.head->next->next->data == 20);
 
     // Delete
-    list_delete(&head, 15);
+    list_delete(&list, 15);
     my_assert(node->next->data == 20);
 
     // Search
-    Node *found = list_search(&head, 20);
+    Node *found = list_search(&list, 20);
     my_assert(found->data == 20);
 
-    list_cleanup(&head);
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_tail_and_count() {
+    printf_yellow("  Testing list tail and count tracking ---> ");
+    List list;
+    list_init(&list, sizeof(Node) * 4);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    my_assert(list.tail->data == 20);
+
+    // Inserting after the tail moves the tail
+    list_insert_after(&list, list.tail, 30);
+    my_assert(list.tail->data == 30);
+    list_insert(&list, 40);
+    my_assert(list.tail->data == 40);
+    my_assert(list.tail->next == NULL);
+    my_assert(list_count_nodes(&list) == 4);
+
+    // Deleting the tail moves it back
+    list_delete(&list, 40);
+    my_assert(list.tail->data == 30);
+    my_assert(list_count_nodes(&list) == 3);
+
+    list_delete(&list, 10);
+    list_delete(&list, 20);
+    list_delete(&list, 30);
+    my_assert(list.head == NULL && list.tail == NULL);
+    my_assert(list_count_nodes(&list) == 0);
+
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_node_pool() {
+    printf_yellow("  Testing list node pool ---> ");
+    List list;
+    list_init(&list, sizeof(Node) * 3);
+    list_insert(&list, 10);
+    list_insert(&list, 20);
+    list_insert(&list, 30);
+
+    // Nodes are carved back to back from one region
+    Node *second = list.head->next;
+    my_assert(second == list.head + 1 && list.tail == list.head + 2);
+
+    // A deleted node is handed out again by the next insertion
+    list_delete(&list, 20);
+    list_insert(&list, 40);
+    my_assert(list.tail == second && list.tail->data == 40);
+    my_assert(list_count_nodes(&list) == 3);
+
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+// First node holding `data`, found without the value index.
+static Node *naive_search(List *list, uint16_t data) {
+    for (Node *node = list->head; node; node = node->next)
+        if (node->data == data) return node;
+    return NULL;
+}
+
+void test_list_index() {
+    printf_yellow("  Testing list value index ---> ");
+    List list;
+    int count = 2000;
+    list_init(&list, sizeof(Node) * count);
+    for (int i = 0; i < 100; i++) list_insert(&list, i % 10);
+    list_index_enable(&list);
+
+    // Mix every kind of insertion and deletion over a small value range so
+    // duplicates are common, checking against a plain scan as we go
+    for (int i = 0; i < count - 100; i++) {
+        uint16_t value = rand() % 20;
+        Node *node = naive_search(&list, rand() % 20);
+        switch (rand() % 4) {
+            case 0:
+                list_insert(&list, value);
+                break;
+            case 1:
+                if (node) list_insert_after(&list, node, value);
+                break;
+            case 2:
+                if (node) list_insert_before(&list, node, value);
+                break;
+            case 3:
+                list_delete(&list, value);
+                break;
+        }
+        for (uint16_t v = 0; v < 20; v++)
+            my_assert(list_search(&list, v) == naive_search(&list, v));
+        my_assert(list.tail == NULL || list.tail->next == NULL);
+    }
+    my_assert(list_search(&list, 12345) == NULL);
+
+    // Deleting everything through the index empties the list
+    for (uint16_t v = 0; v < 20; v++)
+        while (list_search(&list, v)) list_delete(&list, v);
+    my_assert(list.head == NULL && list.tail == NULL);
+    my_assert(list_count_nodes(&list) == 0);
+
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+// Whether every tower level visits its nodes in list order, each tower
+// standing on one node all the way down.
+static int skip_towers_in_order(List *list) {
+    for (int level = 0; level < list->skip->levels; level++) {
+        Node *node = list->head;
+        for (SkipIndex *index = list->skip->head[level]; index;
+             index = index->right) {
+            while (node && node != index->node) node = node->next;
+            if (!node) return 0;
+            if (level > 0 && index->down->node != node) return 0;
+        }
+    }
+    return 1;
+}
+
+void test_list_sorted() {
+    printf_yellow("  Testing sorted list with skip-list towers ---> ");
+    List list;
+    int count = 2000;
+    list_init_sorted(&list, sizeof(Node) * count);
+    srand(7);
+    for (int i = 0; i < count; i++) list_insert(&list, rand() % 1000);
+    my_assert(list_count_nodes(&list) == count);
+
+    // Random deletions, some of values that are not there
+    for (int i = 0; i < count / 2; i++) list_delete(&list, rand() % 1200);
+    list_insert(&list, 0);
+    list_insert(&list, 1000);
+
+    int nodes = 0;
+    for (Node *node = list.head; node; node = node->next, nodes++) {
+        if (node->next) my_assert(node->data <= node->next->data);
+        my_assert(node->next || list.tail == node);
+    }
+    my_assert(nodes == list_count_nodes(&list));
+    for (uint16_t v = 0; v <= 1200; v++) {
+        my_assert(list_search(&list, v) == naive_search(&list, v));
+        Node *bound = list_lower_bound(&list, v);
+        my_assert(!bound || bound->data >= v);
+    }
+
+    // Order-breaking insertions next to a known node are refused
+    Node *first = list.head, *last = list.tail;
+    list_insert_after(&list, last, 999);
+    list_insert_before(&list, first, 1);
+    my_assert(list_count_nodes(&list) == nodes);
+    my_assert(list.head == first && list.tail == last);
+    my_assert(first->data == 0);
+    my_assert(last->data == 1000 && last->next == NULL);
+
+    // Accepted ones get towers in list order, so they can be deleted again
+    list_insert_after(&list, last, 1000);
+    my_assert(list_count_nodes(&list) == nodes + 1 && list.tail != last);
+    for (int i = 0; i < count / 4; i++) {
+        Node *node = list_search(&list, rand() % 1000);
+        if (!node) continue;
+        if (i % 2)
+            list_insert_after(&list, node, node->data);
+        else
+            list_insert_before(&list, node, node->data);
+    }
+    my_assert(skip_towers_in_order(&list));
+    for (uint16_t v = 0; v <= 1000; v++) {
+        int copies = 0;
+        for (Node *node = list.head; node; node = node->next)
+            copies += node->data == v;
+        for (int i = 0; i < copies; i++) list_delete(&list, v);
+        my_assert(list_search(&list, v) == NULL);
+    }
+    my_assert(list.head == NULL && list_count_nodes(&list) == 0);
+    my_assert(list.skip->levels == 0);
+    list_cleanup(&list);
+
+    // A pool that cannot be mapped leaves an empty list
+    list_init_sorted(&list, (size_t)1 << 62);
+    my_assert(list.head == NULL && list.skip == NULL);
+    list_insert(&list, 1);
+    my_assert(list_count_nodes(&list) == 0);
+    list_cleanup(&list);
+
+    // Range display finds both ends through the towers
+    char buffer[64];
+    list_init_sorted(&list, sizeof(Node) * 6);
+    int values[] = {40, 10, 30, 20, 50, 30};
+    for (int i = 0; i < 6; i++) list_insert(&list, values[i]);
+    FILE *original_stdout = stdout;
+    FILE *fp = tmpfile();
+    stdout = fp;
+    list_display_values(&list, 15, 40);
+    list_display_values(&list, 41, 49);
+    fflush(fp);
+    rewind(fp);
+    size_t length = fread(buffer, 1, sizeof(buffer) - 1, fp);
+    buffer[length] = '\0';
+    fclose(fp);
+    stdout = original_stdout;
+    my_assert(strcmp(buffer, "[20, 30, 30, 40][]") == 0);
+
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_bulk() {
+    printf_yellow("  Testing bulk construction and export ---> ");
+    int count = 1000;
+    uint16_t *values = malloc(count * sizeof(uint16_t));
+    uint16_t *copy = malloc(count * sizeof(uint16_t));
+    for (int i = 0; i < count; i++) values[i] = (i * 37) % 1000;
+
+    // All nodes come from one contiguous run
+    List list;
+    list_from_array(&list, values, count);
+    my_assert(list_count_nodes(&list) == count);
+    my_assert(list.tail == list.head + count - 1 && list.tail->next == NULL);
+    my_assert(list_to_array(&list, copy, count) == (size_t)count);
+    my_assert(memcmp(values, copy, count * sizeof(uint16_t)) == 0);
+
+    // Appending to a full pool reuses deleted nodes, then stops
+    for (int i = 0; i < 10; i++) list_delete(&list, values[i]);
+    my_assert(list_append_array(&list, values, 10) == 10);
+    my_assert(list_append_array(&list, values, 1) == 0);
+    my_assert(list_to_array(&list, copy, count) == (size_t)count);
+    my_assert(memcmp(values + 10, copy, (count - 10) * sizeof(uint16_t)) == 0);
+    my_assert(memcmp(values, copy + count - 10, 10 * sizeof(uint16_t)) == 0);
+    my_assert(list.tail->data == values[9] && list.tail->next == NULL);
+
+    // Export stops at the array's capacity
+    my_assert(list_to_array(&list, copy, 5) == 5);
+    list_cleanup(&list);
+
+    // The attached variant leaves other lists in the pool alone and keeps
+    // every value even when its region starts unaligned
+    List other;
+    mem_init(3 + sizeof(Node) * (count + 1) + 2 * NODE_POOL_SLACK);
+    mem_alloc(3);
+    list_attach(&other, sizeof(Node));
+    list_insert(&other, 7);
+    list_from_array_attached(&list, values, count);
+    my_assert((uintptr_t)list.pool.region % sizeof(void *) != 0);
+    my_assert(list_count_nodes(&list) == count);
+    my_assert(list_to_array(&list, copy, count) == (size_t)count);
+    my_assert(memcmp(values, copy, count * sizeof(uint16_t)) == 0);
+    my_assert(other.head->data == 7 && list_count_nodes(&other) == 1);
+    list_cleanup(&list);
+    list_cleanup(&other);
+    mem_deinit();
+
+    free(values);
+    free(copy);
+    printf_green("[PASS].\n");
+}
+
+void test_list_display_stream() {
+    printf_yellow("  Testing buffered list display ---> ");
+    int count = 10000;  // Several buffers' worth of output
+    List list;
+    list_init(&list, sizeof(Node) * count);
+    for (int i = 0; i < count; i++) list_insert(&list, (i * 7919) % 65536);
+
+    size_t size = count * 8 + 3;
+    char *expected = malloc(size);
+    char *buffer = malloc(size);
+    size_t length = 0;
+    expected[length++] = '[';
+    for (Node *node = list.head; node; node = node->next)
+        length += sprintf(expected + length, node == list.head ? "%d" : ", %d",
+                          node->data);
+    expected[length++] = ']';
+
+    // The stream gets the whole list and then a two-node range
+    FILE *stream = tmpfile();
+    list_display_range_to(&list, NULL, NULL, stream);
+    list_display_range_to(&list, list.head->next, list.head->next->next,
+                          stream);
+    rewind(stream);
+    my_assert(fread(buffer, 1, size, stream) == length + 13);
+    my_assert(memcmp(buffer, expected, length) == 0);
+    my_assert(memcmp(buffer + length, "[7919, 15838]", 13) == 0);
+    fclose(stream);
+
+    FILE *file = tmpfile();
+    list_display_range_fd(&list, NULL, NULL, fileno(file));
+    rewind(file);
+    my_assert(fread(buffer, 1, size, file) == length);
+    my_assert(memcmp(buffer, expected, length) == 0);
+    fclose(file);
+
+    free(expected);
+    free(buffer);
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_shared_pool() {
+    printf_yellow("  Testing lists sharing one pool ---> ");
+    int lists = 1000, per_list = 4;
+    size_t region = sizeof(Node) * per_list + NODE_POOL_SLACK;
+    mem_init(region * lists);
+    List *all = malloc(lists * sizeof(List));
+    for (int i = 0; i < lists; i++) {
+        list_attach(&all[i], sizeof(Node) * per_list);
+        for (int k = 0; k < per_list; k++) list_insert(&all[i], i + k);
+    }
+
+    // Cleaning one list up leaves the others intact and its space reusable
+    list_cleanup(&all[1]);
+    list_attach(&all[1], sizeof(Node) * per_list);
+    list_insert(&all[1], 12345);
+    my_assert((char *)all[1].pool.region ==
+              (char *)all[0].pool.region + region);
+    for (int i = 0; i < lists; i++) {
+        if (i == 1) continue;
+        my_assert(list_count_nodes(&all[i]) == per_list);
+        my_assert(all[i].head->data == i && all[i].tail->data == i + 3);
+    }
+    my_assert(list_count_nodes(&all[1]) == 1);
+
+    // Once every list is gone the whole pool is free again
+    for (int i = 0; i < lists; i++) list_cleanup(&all[i]);
+    List big;
+    list_attach(&big, region * lists - NODE_POOL_SLACK);
+    my_assert(big.pool.region != NULL);
+    list_cleanup(&big);
+
+    // A region placed after an odd-sized block still holds every node
+    void *odd = mem_alloc(3);
+    list_attach(&big, sizeof(Node) * per_list);
+    for (int k = 0; k < per_list; k++) list_insert(&big, k);
+    my_assert(list_count_nodes(&big) == per_list);
+    my_assert((uintptr_t)big.head % sizeof(void *) == 0);
+    list_cleanup(&big);
+    mem_free(odd);
+
+    // Every list kind can be attached next to a plain list
+    static ConcList conc;
+    List sorted;
+    DList dlist;
+    UnrolledList ulist;
+    CompactList clist;
+    list_attach(&big, sizeof(Node) * per_list);
+    odd = mem_alloc(3);
+    list_attach_sorted(&sorted, sizeof(Node) * 64);
+    my_assert((uintptr_t)sorted.skip % sizeof(void *) == 0);
+    dlist_attach(&dlist, sizeof(DNode) * 16);
+    ulist_attach(&ulist, sizeof(UnrolledNode) * 4);
+    clist_attach(&clist);
+    conclist_init_attached(&conc, sizeof(ConcNode) * 64);
+    ConcThread *self = conclist_attach(&conc);
+    for (int k = 0; k < per_list; k++) list_insert(&big, k);
+    for (int k = 0; k < 16; k++) {
+        list_insert(&sorted, 15 - k);
+        dlist_insert(&dlist, k);
+        ulist_insert(&ulist, k);
+        clist_insert(&clist, k);
+        conclist_insert(&conc, self, k);
+    }
+    my_assert(sorted.head->data == 0 && list_search(&sorted, 9) != NULL);
+    my_assert(dlist_count(&dlist) == 16 && ulist_count(&ulist) == 16);
+    my_assert(clist_count(&clist) == 16 && conclist_count(&conc) == 16);
+    list_cleanup(&sorted);
+    mem_free(odd);
+    dlist_cleanup(&dlist);
+    ulist_cleanup(&ulist);
+    clist_cleanup(&clist);
+    conclist_cleanup(&conc);
+    my_assert(list_count_nodes(&big) == per_list);
+    my_assert(big.head->data == 0 && big.tail->data == per_list - 1);
+    list_cleanup(&big);
+
+    free(all);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+static int is_even(uint16_t data, void *ctx) {
+    (void)ctx;
+    return data % 2 == 0;
+}
+
+static int in_range(uint16_t data, void *ctx) {
+    uint16_t *range = ctx;
+    return data >= range[0] && data < range[1];
+}
+
+void test_list_delete_if() {
+    printf_yellow("  Testing single-pass delete of all matches ---> ");
+    List list;
+    int count = 1000;
+    list_init(&list, sizeof(Node) * count);
+    for (int i = 0; i < count; i++) list_insert(&list, i % 10);
+    list_index_enable(&list);
+
+    my_assert(list_delete_all(&list, 3) == 100);
+    my_assert(list_delete_all(&list, 3) == 0);
+    my_assert(list_delete_if(&list, is_even, NULL) == 500);
+    my_assert(list_count_nodes(&list) == 400);
+    for (uint16_t v = 0; v < 10; v++)
+        my_assert(list_search(&list, v) == naive_search(&list, v));
+    my_assert(list.tail->data == 9 && list.tail->next == NULL);
+
+    // Every removed node can be handed out again
+    for (int i = 0; i < 600; i++) list_insert(&list, 3);
+    my_assert(list_count_nodes(&list) == count);
+    my_assert(list_delete_all(&list, 3) == 600);
+    list_cleanup(&list);
+
+    // On a sorted list the towers are updated in the same pass
+    list_init_sorted(&list, sizeof(Node) * count);
+    for (int i = 0; i < count; i++) list_insert(&list, rand() % 500);
+    uint16_t range[] = {100, 200};
+    size_t removed = list_delete_if(&list, in_range, range);
+    removed += list_delete_all(&list, 300);
+    my_assert(list_count_nodes(&list) == count - (int)removed);
+    for (Node *node = list.head; node; node = node->next) {
+        my_assert(!in_range(node->data, range) && node->data != 300);
+        my_assert(!node->next || node->data <= node->next->data);
+    }
+    for (uint16_t v = 0; v < 500; v++)
+        my_assert(list_search(&list, v) == naive_search(&list, v));
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_compact() {
+    printf_yellow("  Testing list compaction ---> ");
+    List list;
+    int count = 2000;
+    list_init(&list, sizeof(Node) * count);
+    for (int i = 0; i < count / 2; i++) list_insert(&list, i);
+    list_index_enable(&list);
+
+    // Churn so that traversal order no longer follows the region
+    for (int i = 0; i < count; i++) {
+        Node *node = naive_search(&list, rand() % 1000);
+        if (rand() % 2 && node)
+            list_insert_after(&list, node, 1000 + i);
+        else
+            list_delete(&list, rand() % 1000);
+    }
+    int nodes = list_count_nodes(&list);
+    uint16_t *before = malloc(nodes * sizeof(uint16_t));
+    uint16_t *after = malloc(nodes * sizeof(uint16_t));
+    list_to_array(&list, before, nodes);
+    Node *held = list.head->next->next;
+    uint16_t held_data = held->data;
+
+    ListRemap remap;
+    list_compact(&list, &remap);
+    my_assert(list_to_array(&list, after, nodes) == (size_t)nodes);
+    my_assert(memcmp(before, after, nodes * sizeof(uint16_t)) == 0);
+    my_assert(list.tail == list.head + nodes - 1 && list.tail->next == NULL);
+    my_assert(list_remap(&remap, held) == list.head + 2);
+    my_assert(list_remap(&remap, held)->data == held_data);
+    for (uint16_t v = 0; v < 1000; v += 7)
+        my_assert(list_search(&list, v) == naive_search(&list, v));
+    list_remap_free(&remap);
+
+    // The space after the compacted nodes is handed out in order
+    list_insert(&list, 42);
+    my_assert(list.tail == list.head + nodes);
+    list_cleanup(&list);
+
+    // Towers follow the nodes they index
+    list_init_sorted(&list, sizeof(Node) * count);
+    for (int i = 0; i < count; i++) list_insert(&list, rand() % 1000);
+    for (int i = 0; i < count / 2; i++) list_delete(&list, rand() % 1000);
+    list_compact(&list, NULL);
+    for (uint16_t v = 0; v < 1000; v++)
+        my_assert(list_search(&list, v) == naive_search(&list, v));
+    list_cleanup(&list);
+
+    free(before);
+    free(after);
+    printf_green("[PASS].\n");
+}
+
+typedef struct VisitState {
+    uint16_t *values;
+    size_t count;
+    int batches;
+} VisitState;
+
+static void collect_values(const uint16_t *values, size_t count, void *ctx) {
+    VisitState *state = ctx;
+    memcpy(state->values + state->count, values, count * sizeof(uint16_t));
+    state->count += count;
+    state->batches++;
+}
+
+void test_list_visit() {
+    printf_yellow("  Testing batched iteration ---> ");
+    List list;
+    int count = 3 * LIST_BATCH + 5;  // A partial batch at the end
+    list_init(&list, sizeof(Node) * count);
+    uint16_t *expected = malloc(count * sizeof(uint16_t));
+    uint16_t *values = malloc(count * sizeof(uint16_t));
+
+    // An empty list yields no batches
+    VisitState state = {values, 0, 0};
+    list_visit(&list, collect_values, &state);
+    my_assert(state.count == 0 && state.batches == 0);
+
+    for (int i = 0; i < count; i++) list_insert(&list, rand());
+    list_to_array(&list, expected, count);
+    list_visit(&list, collect_values, &state);
+    my_assert(state.count == (size_t)count && state.batches == 4);
+    my_assert(memcmp(values, expected, count * sizeof(uint16_t)) == 0);
+
+    ListIter iter;
+    size_t read = 0, batch;
+    list_iter_init(&iter, &list);
+    while ((batch = list_iter_next(&iter))) {
+        my_assert(batch == LIST_BATCH || read + batch == (size_t)count);
+        my_assert(memcmp(iter.values, expected + read,
+                         batch * sizeof(uint16_t)) == 0);
+        read += batch;
+    }
+    my_assert(read == (size_t)count && list_iter_next(&iter) == 0);
+
+    free(expected);
+    free(values);
+    list_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_list_save_load() {
+    printf_yellow("  Testing binary save and load ---> ");
+    char raw_path[] = "/tmp/test_list_XXXXXX";
+    char delta_path[] = "/tmp/test_list_XXXXXX";
+    close(mkstemp(raw_path));
+    close(mkstemp(delta_path));
+    int count = 5000;
+    uint16_t *expected = malloc(count * sizeof(uint16_t));
+    uint16_t *values = malloc(count * sizeof(uint16_t));
+    for (int i = 0; i < count; i++)
+        expected[i] = i % 3 ? rand() : 65535 - i;  // Large jumps both ways
+
+    List list, loaded;
+    list_from_array(&list, expected, count);
+    my_assert(list_save(&list, raw_path, LIST_ENCODING_RAW));
+    my_assert(list_save(&list, delta_path, LIST_ENCODING_DELTA));
+    list_cleanup(&list);
+
+    my_assert(list_load(&loaded, raw_path));
+    my_assert(list_count_nodes(&loaded) == count);
+    my_assert(list_to_array(&loaded, values, count) == (size_t)count);
+    my_assert(memcmp(values, expected, count * sizeof(uint16_t)) == 0);
+    my_assert(loaded.tail == loaded.head + count - 1);
+    list_cleanup(&loaded);
+
+    my_assert(list_load(&loaded, delta_path));
+    my_assert(list_to_array(&loaded, values, count) == (size_t)count);
+    my_assert(memcmp(values, expected, count * sizeof(uint16_t)) == 0);
+    list_cleanup(&loaded);
+
+    // Sorted values pack into about a byte each
+    for (int i = 0; i < count; i++) expected[i] = i * 3;
+    list_from_array(&list, expected, count);
+    my_assert(list_save(&list, delta_path, LIST_ENCODING_DELTA));
+    list_cleanup(&list);
+    FILE *fp = fopen(delta_path, "rb");
+    fseek(fp, 0, SEEK_END);
+    my_assert(ftell(fp) == 16 + count);
+    fclose(fp);
+    my_assert(list_load(&loaded, delta_path));
+    my_assert(list_to_array(&loaded, values, count) == (size_t)count);
+    my_assert(memcmp(values, expected, count * sizeof(uint16_t)) == 0);
+    list_cleanup(&loaded);
+
+    // The attached variant loads next to lists already in the pool, even
+    // into a region that starts unaligned
+    mem_init(3 + sizeof(Node) * (count + 1) + 2 * NODE_POOL_SLACK);
+    mem_alloc(3);
+    list_attach(&list, sizeof(Node));
+    list_insert(&list, 7);
+    my_assert(list_load_attached(&loaded, delta_path));
+    my_assert((uintptr_t)loaded.pool.region % sizeof(void *) != 0);
+    my_assert(list_to_array(&loaded, values, count) == (size_t)count);
+    my_assert(memcmp(values, expected, count * sizeof(uint16_t)) == 0);
+    my_assert(list.head->data == 7 && list_count_nodes(&list) == 1);
+    list_cleanup(&loaded);
+
+    // Without room for every node the load fails and leaves the pool as it was
+    void *blocker = mem_alloc(sizeof(Node));
+    my_assert(!list_load_attached(&loaded, delta_path));
+    mem_free(blocker);
+    my_assert(list_load_attached(&loaded, delta_path));
+    list_cleanup(&loaded);
+    list_cleanup(&list);
+    mem_deinit();
+
+    // An empty list round-trips, a truncated file is refused
+    list_init(&list, sizeof(Node));
+    my_assert(list_save(&list, raw_path, LIST_ENCODING_RAW));
+    list_cleanup(&list);
+    my_assert(list_load(&loaded, raw_path));
+    my_assert(loaded.head == NULL && list_count_nodes(&loaded) == 0);
+    list_cleanup(&loaded);
+    my_assert(truncate(delta_path, 16 + count / 2) == 0);
+    my_assert(!list_load(&loaded, delta_path));
+
+    unlink(raw_path);
+    unlink(delta_path);
+    free(expected);
+    free(values);
+    printf_green("[PASS].\n");
+}
+
+// ********* Doubly linked list *********
+
+void test_dlist_operations() {
+    printf_yellow("  Testing doubly linked list operations ---> ");
+    DList list;
+    dlist_init(&list, sizeof(DNode) * 5);
+    dlist_insert(&list, 10);
+    dlist_insert(&list, 30);
+
+    // Insert before the head, before a middle node and after the tail
+    dlist_insert_before(&list, list.head, 5);
+    DNode *node = dlist_search(&list, 30);
+    dlist_insert_before(&list, node, 20);
+    dlist_insert_after(&list, list.tail, 40);
+    my_assert(dlist_count(&list) == 5);
+
+    // Both directions see the same order
+    uint16_t expected[] = {5, 10, 20, 30, 40};
+    DNode *current = list.head;
+    for (int i = 0; i < 5; i++, current = current->next)
+        my_assert(current->data == expected[i]);
+    current = list.tail;
+    for (int i = 4; i >= 0; i--, current = current->prev)
+        my_assert(current->data == expected[i]);
+
+    // Remove known nodes at the ends and in the middle
+    dlist_remove_node(&list, list.head);
+    dlist_remove_node(&list, list.tail);
+    dlist_remove_node(&list, dlist_search(&list, 20));
+    my_assert(list.head->data == 10 && list.tail->data == 30);
+    my_assert(list.head->next == list.tail && list.tail->prev == list.head);
+    my_assert(list.head->prev == NULL && list.tail->next == NULL);
+
+    dlist_delete(&list, 10);
+    dlist_delete(&list, 30);
+    my_assert(list.head == NULL && list.tail == NULL);
+    my_assert(dlist_count(&list) == 0);
+
+    dlist_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+// ********* Concurrent linked list *********
+
+typedef struct ConcWorker {
+    ConcList *list;
+    int id;
+} ConcWorker;
+
+// Each worker inserts its own 500 values, deletes every other one and keeps
+// checking that the rest stay visible.
+static void *conc_worker(void *arg) {
+    ConcWorker *worker = arg;
+    ConcThread *self = conclist_attach(worker->list);
+    for (int i = 0; i < 500; i++)
+        conclist_insert(worker->list, self, worker->id * 1000 + i);
+    for (int i = 0; i < 500; i += 2) {
+        my_assert(conclist_delete(worker->list, self, worker->id * 1000 + i));
+        my_assert(
+            conclist_contains(worker->list, self, worker->id * 1000 + i + 1));
+    }
+    return NULL;
+}
+
+// Each worker toggles keys of a small set shared by all of them, so nodes
+// retired by one thread are the ones others are about to insert again.
+static void *conc_churn_worker(void *arg) {
+    ConcWorker *worker = arg;
+    ConcThread *self = conclist_attach(worker->list);
+    unsigned seed = worker->id;
+    for (int i = 0; i < 100000; i++) {
+        uint16_t key = rand_r(&seed) % 64;
+        if (conclist_contains(worker->list, self, key))
+            conclist_delete(worker->list, self, key);
+        else
+            my_assert(conclist_insert(worker->list, self, key));
+    }
+    return NULL;
+}
+
+void test_conclist_operations() {
+    printf_yellow("  Testing concurrent list operations ---> ");
+    static ConcList list;
+    conclist_init(&list, sizeof(ConcNode) * 4096);
+
+    // Values come back in ascending order
+    ConcThread *self = conclist_attach(&list);
+    conclist_insert(&list, self, 30);
+    conclist_insert(&list, self, 10);
+    conclist_insert(&list, self, 20);
+    my_assert(conclist_contains(&list, self, 20));
+    my_assert(!conclist_contains(&list, self, 25));
+    my_assert(conclist_delete(&list, self, 20));
+    my_assert(!conclist_delete(&list, self, 20));
+    my_assert(!conclist_contains(&list, self, 20));
+    conclist_delete(&list, self, 10);
+    conclist_delete(&list, self, 30);
+    my_assert(conclist_count(&list) == 0);
+
+    // Parallel writers and readers on disjoint ranges
+    pthread_t threads[4];
+    ConcWorker workers[4];
+    for (int i = 0; i < 4; i++) {
+        workers[i] = (ConcWorker){&list, i + 1};
+        pthread_create(&threads[i], NULL, conc_worker, &workers[i]);
+    }
+    for (int i = 0; i < 4; i++) pthread_join(threads[i], NULL);
+    my_assert(conclist_count(&list) == 4 * 250);
+
+    // The survivors are the odd offsets, in ascending order
+    int previous = -1;
+    int seen = 0;
+    for (ConcNode *node = (ConcNode *)atomic_load(&list.head.next); node;
+         node = (ConcNode *)atomic_load(&node->next)) {
+        my_assert(node->data > previous && node->data % 2 == 1);
+        previous = node->data;
+        seen++;
+    }
+    my_assert(seen == 4 * 250);
+    conclist_cleanup(&list);
+
+    // Overlapping keys churn through a pool far smaller than the number of
+    // inserts, so it only lasts if retired nodes flow back between threads
+    conclist_init(&list, sizeof(ConcNode) * 2048);
+    for (int i = 0; i < 4; i++) {
+        workers[i] = (ConcWorker){&list, i + 1};
+        pthread_create(&threads[i], NULL, conc_churn_worker, &workers[i]);
+    }
+    for (int i = 0; i < 4; i++) pthread_join(threads[i], NULL);
+    previous = -1;
+    seen = 0;
+    for (ConcNode *node = (ConcNode *)atomic_load(&list.head.next); node;
+         node = (ConcNode *)atomic_load(&node->next)) {
+        my_assert(node->data >= previous && node->data < 64);
+        previous = node->data;
+        seen++;
+    }
+    my_assert(conclist_count(&list) == (size_t)seen);
+
+    conclist_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+// ********* Unrolled linked list *********
+
+// Check that the unrolled list holds exactly `expected`, in order.
+static void ulist_assert_equals(UnrolledList *list, const uint16_t *expected,
+                                int count) {
+    int i = 0;
+    for (UnrolledNode *node = list->head; node; node = node->next) {
+        my_assert(node->count > 0 && node->count <= UNROLLED_CAPACITY);
+        for (int k = 0; k < node->count; k++)
+            my_assert(i < count && node->values[k] == expected[i++]);
+    }
+    my_assert(i == count);
+    my_assert(ulist_count(list) == count);
+}
+
+void test_ulist_operations() {
+    printf_yellow("  Testing unrolled list operations ---> ");
+    my_assert(sizeof(UnrolledNode) == UNROLLED_NODE_SIZE);
+
+    int count = 200;
+    uint16_t expected[count + 2];  // Room for the two insertions below
+    UnrolledList list;
+    ulist_init(&list, sizeof(UnrolledNode) * count);
+    for (int i = 0; i < count; i++) {
+        ulist_insert(&list, i);
+        expected[i] = i;
+    }
+    ulist_assert_equals(&list, expected, count);
+
+    // Inserting into a full node splits it
+    UnrolledPos pos = ulist_search(&list, 5);
+    my_assert(pos.node && pos.node->values[pos.index] == 5);
+    ulist_insert_after(&list, pos, 1000);
+    memmove(expected + 7, expected + 6, (count - 6) * sizeof(uint16_t));
+    expected[6] = 1000;
+    count++;
+    ulist_assert_equals(&list, expected, count);
+
+    // Inserting after the last value extends the tail
+    pos = ulist_search(&list, 199);
+    ulist_insert_after(&list, pos, 2000);
+    expected[count++] = 2000;
+    ulist_assert_equals(&list, expected, count);
+    my_assert(list.tail->values[list.tail->count - 1] == 2000);
+
+    // Deleting merges and borrows until the list is empty
+    my_assert(ulist_search(&list, 3000).node == NULL);
+    while (count > 0) {
+        int victim = rand() % count;
+        ulist_delete(&list, expected[victim]);
+        memmove(expected + victim, expected + victim + 1,
+                (count - victim - 1) * sizeof(uint16_t));
+        count--;
+        ulist_assert_equals(&list, expected, count);
+    }
+    my_assert(list.head == NULL && list.tail == NULL);
+
+    ulist_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+void test_ulist_search() {
+    printf_yellow("  Testing unrolled list search ---> ");
+    UnrolledList list;
+    ulist_init(&list, sizeof(UnrolledNode) * 8);
+
+    // Every slot of a node holds a distinct value, then repeat them all
+    for (int i = 0; i < (int)UNROLLED_CAPACITY * 2; i++)
+        ulist_insert(&list, i % UNROLLED_CAPACITY);
+
+    // Each value is found at its first occurrence, in any lane
+    for (int i = 0; i < (int)UNROLLED_CAPACITY; i++) {
+        UnrolledPos pos = ulist_search(&list, i);
+        my_assert(pos.node == list.head && pos.index == i);
+    }
+    my_assert(ulist_search(&list, UNROLLED_CAPACITY).node == NULL);
+
+    // Values past the first node are found in later nodes
+    ulist_insert(&list, 500);
+    UnrolledPos pos = ulist_search(&list, 500);
+    my_assert(pos.node == list.tail && pos.node->values[pos.index] == 500);
+
+    ulist_cleanup(&list);
+    printf_green("[PASS].\n");
+}
+
+// ********* Compact index-linked list *********
+
+void test_clist_operations() {
+    printf_yellow("  Testing compact list operations ---> ");
+    my_assert(sizeof(CompactNode) == 8);
+
+    CompactList list;
+    clist_init(&list, sizeof(CompactNode) * 256);
+    CompactHandle first = clist_insert(&list, 0);
+    for (int i = 1; i < 200; i++) clist_insert(&list, i);
+    my_assert(clist_count(&list) == 200);
+
+    // Handles taken before the array grew still refer to the same node
+    my_assert(clist_data(&list, first) == 0);
+    CompactHandle node = clist_insert_after(&list, first, 1000);
+    my_assert(list.nodes[first].next == node);
+    my_assert(clist_data(&list, list.nodes[node].next) == 1);
+    my_assert(clist_search(&list, 1000) == node);
+
+    // Deleted nodes are reused
+    clist_delete(&list, 1000);
+    my_assert(clist_search(&list, 1000) == COMPACT_NIL);
+    my_assert(clist_insert(&list, 2000) == node);
+    my_assert(list.tail == node);
+
+    // Traversal order is intact
+    CompactHandle current = list.head;
+    for (int i = 0; i < 200; i++) {
+        my_assert(clist_data(&list, current) == i);
+        current = list.nodes[current].next;
+    }
+    my_assert(clist_data(&list, current) == 2000);
+    my_assert(list.nodes[current].next == COMPACT_NIL);
+
+    clist_cleanup(&list);
     printf_green("[PASS].\n");
 }
 
@@ -479,6 +1355,53 @@ int main(int argc, char *argv[]) {
         printf(" 12. test_list_delete_loop - Test multiple detelions\n");
         printf(" 13. test_list_search_loop - Test multiple search\n");
         printf(" 14. test_list_edge_cases - Test edge cases\n");
+        printf(
+            " 15. test_list_tail_and_count - Test constant time append and "
+            "count\n");
+
+        printf("\nList Variants:\n");
+        printf(
+            " 16. test_ulist_operations - Test the unrolled list with node "
+            "split and merge\n");
+        printf(" 17. test_ulist_search - Test vectorized unrolled search\n");
+        printf(
+            " 20. test_clist_operations - Test the compact index-linked "
+            "list\n");
+        printf(
+            " 21. test_dlist_operations - Test the doubly linked list\n");
+        printf(
+            " 22. test_conclist_operations - Test the concurrent list with "
+            "parallel writers\n");
+
+        printf("\nAcceleration:\n");
+        printf(
+            " 18. test_list_index - Test constant time search and delete "
+            "through the value index\n");
+        printf(" 19. test_list_node_pool - Test node reuse from the pool\n");
+        printf(
+            " 23. test_list_sorted - Test the sorted list with skip-list "
+            "towers\n");
+        printf(
+            " 24. test_list_bulk - Test construction from and export to "
+            "arrays\n");
+        printf(
+            " 25. test_list_display_stream - Test buffered display to a "
+            "stream and a file descriptor\n");
+        printf(
+            " 26. test_list_shared_pool - Test many lists attached to one "
+            "pool\n");
+        printf(
+            " 27. test_list_delete_if - Test deleting every match in one "
+            "pass\n");
+        printf(
+            " 28. test_list_compact - Test relocating nodes in traversal "
+            "order\n");
+        printf(
+            " 29. test_list_visit - Test the batched iterator and "
+            "visitor\n");
+        printf(
+            " 30. test_list_save_load - Test binary serialization of "
+            "lists\n");
         printf(" 0. Run all tests\n");
         return 1;
     }
@@ -505,6 +1428,26 @@ int main(int argc, char *argv[]) {
             test_list_delete_loop(1000);
             test_list_search_loop(1000);
             test_list_edge_cases();
+            test_list_tail_and_count();
+
+            printf("\nTesting List Variants:\n");
+            test_ulist_operations();
+            test_ulist_search();
+            test_clist_operations();
+            test_dlist_operations();
+            test_conclist_operations();
+
+            printf("\nTesting Acceleration:\n");
+            test_list_index();
+            test_list_node_pool();
+            test_list_sorted();
+            test_list_bulk();
+            test_list_display_stream();
+            test_list_shared_pool();
+            test_list_delete_if();
+            test_list_compact();
+            test_list_visit();
+            test_list_save_load();
             break;
         case 1:
             test_list_init();
@@ -549,6 +1492,54 @@ int main(int argc, char *argv[]) {
         case 14:
             test_list_edge_cases();
             break;
+        case 15:
+            test_list_tail_and_count();
+            break;
+        case 16:
+            test_ulist_operations();
+            break;
+        case 17:
+            test_ulist_search();
+            break;
+        case 18:
+            test_list_index();
+            break;
+        case 19:
+            test_list_node_pool();
+            break;
+        case 20:
+            test_clist_operations();
+            break;
+        case 21:
+            test_dlist_operations();
+            break;
+        case 22:
+            test_conclist_operations();
+            break;
+        case 23:
+            test_list_sorted();
+            break;
+        case 24:
+            test_list_bulk();
+            break;
+        case 25:
+            test_list_display_stream();
+            break;
+        case 26:
+            test_list_shared_pool();
+            break;
+        case 27:
+            test_list_delete_if();
+            break;
+        case 28:
+            test_list_compact();
+            break;
+        case 29:
+            test_list_visit();
+            break;
+        case 30:
+            test_list_save_load();
+            break;
 
         default:
             printf("Invalid test function\n");
@@ -1,8 +1,10 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "common_defs.h"
 #include "gitdata.h"
@@ -317,6 +319,266 @@ void test_edge_case_allocations() {
     printf_green("[PASS].\n");
 }
 
+static void *free_on_other_thread(void *block) {
+    mem_free(block);
+    return NULL;
+}
+
+void test_remote_free() {
+    printf_yellow("  Testing mem_free from a non-owning thread ---> ");
+    mem_init(1024);
+
+    void *block1 = mem_alloc(512);
+    void *block2 = mem_alloc(512);
+    my_assert(block1 != NULL && block2 != NULL);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, free_on_other_thread, block1);
+    pthread_join(thread, NULL);
+
+    // The queued free is reclaimed by the owner on its next allocation.
+    void *block3 = mem_alloc(512);
+    my_assert(block3 == block1);
+
+    mem_free(block2);
+    mem_free(block3);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_large_alloc() {
+    printf_yellow("  Testing directly mapped large allocations ---> ");
+    mem_init(1024);
+    mem_set_large_threshold(4096);
+
+    // Larger than the pool, but served by its own mapping
+    char *large = mem_alloc(1 << 20);
+    my_assert(large != NULL);
+    memset(large, 0xAB, 1 << 20);
+
+    // The pool is untouched by the large block
+    void *block = mem_alloc(1024);
+    my_assert(block != NULL);
+
+    // Growing keeps the contents without going through the pool
+    large = mem_resize(large, 4 << 20);
+    my_assert(large != NULL);
+    my_assert(large[0] == (char)0xAB && large[(1 << 20) - 1] == (char)0xAB);
+
+    // A pool block resized past the threshold moves out of the pool
+    memset(block, 0xCD, 1024);
+    char *moved = mem_resize(block, 8192);
+    my_assert(moved != NULL && moved[1023] == (char)0xCD);
+    my_assert(mem_alloc(1024) != NULL);
+
+    mem_free(large);
+    mem_free(moved);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_trim() {
+    printf_yellow("  Testing mem_trim and watermarks ---> ");
+    size_t page = sysconf(_SC_PAGESIZE);
+    mem_init(64 * page);
+
+    // Touch the whole pool, then free it again
+    void *block = mem_alloc(64 * page);
+    my_assert(block != NULL);
+    memset(block, 1, 64 * page);
+    mem_free(block);
+
+    // Keeping four pages resident releases the other sixty
+    my_assert(mem_trim(4 * page) == 60 * page);
+    my_assert(mem_trim(0) == 4 * page);
+    my_assert(mem_trim(0) == 0);
+
+    // Freeing past the high watermark trims down to the low watermark
+    mem_set_watermarks(32 * page, 8 * page);
+    block = mem_alloc(64 * page);
+    memset(block, 1, 64 * page);
+    mem_free(block);
+    my_assert(mem_trim(0) == 8 * page);
+
+    // Released pages are still usable
+    block = mem_alloc(64 * page);
+    my_assert(block != NULL);
+    memset(block, 1, 64 * page);
+    mem_free(block);
+
+    // A resize that moves the block keeps its data even when it trims
+    mem_set_watermarks(page, 0);
+    char *data = mem_alloc(16 * page);
+    void *blocker = mem_alloc(page);
+    memset(data, 'x', 16 * page);
+    char *moved = mem_resize(data, 32 * page);
+    my_assert(moved != NULL && moved != data);
+    my_assert(moved[0] == 'x' && moved[16 * page - 1] == 'x');
+
+    // So does a resize that fails and leaves the block where it was
+    my_assert(mem_resize(moved, 128 * page) == NULL);
+    my_assert(moved[0] == 'x' && moved[16 * page - 1] == 'x');
+
+    mem_free(moved);
+    mem_free(blocker);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_alloc_hinted() {
+    printf_yellow("  Testing lifetime-hinted placement ---> ");
+    mem_init(1024);
+
+    char *long1 = mem_alloc_hinted(100, MEM_HINT_LONG_LIVED);
+    char *short1 = mem_alloc_hinted(200, MEM_HINT_TRANSIENT);
+    char *long2 = mem_alloc_hinted(100, MEM_HINT_LONG_LIVED);
+    char *short2 = mem_alloc_hinted(200, MEM_HINT_TRANSIENT);
+
+    // Long-lived blocks grow up from the start, transient ones down from the
+    // end
+    my_assert(long2 == long1 + 100);
+    my_assert(short1 == long1 + 1024 - 200);
+    my_assert(short2 == short1 - 200);
+
+    // Freeing the transient blocks leaves a single gap
+    mem_free(short1);
+    mem_free(short2);
+    void *block = mem_alloc(1024 - 200);
+    my_assert(block == long2 + 100);
+
+    mem_free(block);
+    mem_free(long1);
+    mem_free(long2);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_small_fast_path() {
+    printf_yellow("  Testing inline small-object fast path ---> ");
+    mem_init(1024);
+
+    // Blocks are recycled within their 16-byte size class
+    void *block1 = mem_alloc_small(10);
+    my_assert(block1 != NULL);
+    mem_free_small(block1, 10);
+    void *block2 = mem_alloc_small(16);
+    my_assert(block2 == block1);
+
+    // Larger requests go straight to the pool
+    void *block3 = mem_alloc_small(200);
+    my_assert(block3 != NULL);
+    mem_free_small(block3, 200);
+
+    // Flushing hands cached blocks back, leaving the whole pool free
+    mem_free_small(block2, 16);
+    mem_small_flush();
+    void *block4 = mem_alloc(1024);
+    my_assert(block4 != NULL);
+
+    mem_free(block4);
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_checkpoint() {
+    printf_yellow("  Testing pool checkpoint and restore ---> ");
+    mem_init(1024);
+    char *block1 = mem_alloc(100);
+    char *block2 = mem_alloc(200);
+    char *block3 = mem_alloc(50);
+    memset(block1, 'a', 100);
+    memset(block2, 'b', 200);
+    memset(block3, 'c', 50);
+    mem_free(block2);
+
+    MemCheckpoint *checkpoint = mem_checkpoint();
+    my_assert(checkpoint != NULL);
+
+    // Scribble over everything and change the block list
+    memset(block1, 'x', 100);
+    mem_free(block3);
+    char *block4 = mem_alloc(900);
+    my_assert(block4 != NULL);
+
+    // Contents and layout return to the checkpoint, more than once
+    for (int round = 0; round < 2; round++) {
+        my_assert(mem_restore(checkpoint));
+        for (int i = 0; i < 100; i++) my_assert(block1[i] == 'a');
+        for (int i = 0; i < 50; i++) my_assert(block3[i] == 'c');
+        my_assert(mem_alloc(200) == block1 + 100);
+        my_assert(mem_alloc(1024 - 350 + 1) == NULL);
+    }
+    mem_checkpoint_free(checkpoint);
+
+    // Blocks cached in the owner's small bins are not captured as live
+    mem_deinit();
+    mem_init(1024);
+    mem_free_small(mem_alloc_small(16), 16);
+    checkpoint = mem_checkpoint();
+    my_assert(mem_restore(checkpoint));
+    my_assert(mem_alloc(1024) != NULL);
+    mem_checkpoint_free(checkpoint);
+    mem_deinit();
+    mem_init(1024);
+
+    // Large blocks are not captured
+    mem_set_large_threshold(4096);
+    void *large = mem_alloc(8192);
+    my_assert(mem_checkpoint() == NULL);
+    mem_free(large);
+    checkpoint = mem_checkpoint();
+    my_assert(checkpoint != NULL);
+
+    // A checkpoint only restores into the pool it was taken from
+    mem_deinit();
+    mem_init(1024);
+    my_assert(!mem_restore(checkpoint));
+    mem_checkpoint_free(checkpoint);
+
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
+void test_tagged_alloc() {
+    printf_yellow("  Testing per-tag accounting ---> ");
+    mem_init(4096);
+    enum { LISTS = 1, BUFFERS = 2 };
+
+    void *list1 = mem_alloc_tagged(100, LISTS);
+    void *list2 = mem_alloc_tagged(200, LISTS);
+    void *buffer = mem_alloc_tagged(300, BUFFERS);
+    void *untagged = mem_alloc(50);
+    my_assert(list1 && list2 && buffer && untagged);
+    my_assert(mem_tag_stats(LISTS).live == 300);
+    my_assert(mem_tag_stats(BUFFERS).live == 300);
+    my_assert(mem_tag_stats(0).live == 50);
+    my_assert(mem_alloc_tagged(10, MEM_TAGS) == NULL);
+
+    // Resizing keeps the tag unless told otherwise; peaks remember the most
+    list1 = mem_resize(list1, 400);
+    my_assert(mem_tag_stats(LISTS).live == 600);
+    mem_free(list2);
+    my_assert(mem_tag_stats(LISTS).live == 400);
+    my_assert(mem_tag_stats(LISTS).peak == 600);
+    buffer = mem_resize_tagged(buffer, 150, LISTS);
+    my_assert(mem_tag_stats(LISTS).live == 550);
+    my_assert(mem_tag_stats(BUFFERS).live == 0);
+
+    // A soft limit refuses growth past it but leaves other tags alone
+    mem_set_tag_limit(BUFFERS, 1000);
+    void *big = mem_alloc_tagged(800, BUFFERS);
+    my_assert(big != NULL);
+    my_assert(mem_alloc_tagged(300, BUFFERS) == NULL);
+    my_assert(mem_resize(big, 1001) == NULL);
+    my_assert(mem_resize(big, 1000) != NULL);
+    my_assert(mem_alloc_tagged(300, LISTS) != NULL);
+    my_assert(mem_tag_stats(BUFFERS).live == 1000);
+    my_assert(mem_tag_stats(BUFFERS).limit == 1000);
+
+    mem_deinit();
+    printf_green("[PASS].\n");
+}
+
 int main(int argc, char *argv[]) {
 #ifdef VERSION
     printf("Build Version; %s \n", VERSION);
@@ -372,7 +634,27 @@ int main(int argc, char *argv[]) {
             "bytes, and it does not fail.\n");
         printf(
             " 18. test_random_blocks - Test that we can allocate a random "
-            "size, and random amounts of blocks [1000,10000]. \n\n");
+            "size, and random amounts of blocks [1000,10000]. \n");
+        printf(
+            " 19. test_remote_free - Test that frees from another thread are "
+            "reclaimed by the owner.\n");
+        printf(
+            " 20. test_large_alloc - Test that large allocations bypass the "
+            "pool.\n");
+        printf(
+            " 21. test_trim - Test returning free pages to the kernel.\n");
+        printf(
+            " 22. test_alloc_hinted - Test placement by expected "
+            "lifetime.\n");
+        printf(
+            " 23. test_small_fast_path - Test the inline small-object fast "
+            "path.\n");
+        printf(
+            " 24. test_checkpoint - Test restoring the pool to a "
+            "checkpoint.\n");
+        printf(
+            " 25. test_tagged_alloc - Test per-tag accounting and "
+            "limits.\n\n");
         printf(" 0. Run all tests\n");
         return 1;
     }
@@ -408,6 +690,13 @@ int main(int argc, char *argv[]) {
             printf("\nVarious other tests:\n");
             test_zero_alloc_and_free();
             test_random_blocks();
+            test_remote_free();
+            test_large_alloc();
+            test_trim();
+            test_alloc_hinted();
+            test_small_fast_path();
+            test_checkpoint();
+            test_tagged_alloc();
             break;
         case 1:
             test_init();
@@ -463,6 +752,27 @@ int main(int argc, char *argv[]) {
         case 18:
             test_random_blocks();
             break;
+        case 19:
+            test_remote_free();
+            break;
+        case 20:
+            test_large_alloc();
+            break;
+        case 21:
+            test_trim();
+            break;
+        case 22:
+            test_alloc_hinted();
+            break;
+        case 23:
+            test_small_fast_path();
+            break;
+        case 24:
+            test_checkpoint();
+            break;
+        case 25:
+            test_tagged_alloc();
+            break;
         default:
             printf("Invalid test function\n");
             break;